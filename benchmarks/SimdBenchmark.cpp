@@ -0,0 +1,101 @@
+#include "../include/utils/simdKernels.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using utils::simd::Isa;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void report(const std::string &name, size_t elements, double seconds) {
+  std::cout << name << ": " << elements << " elements, " << seconds << " s, "
+            << static_cast<double>(elements) / seconds / 1e6 << " M elem/s\n";
+}
+
+std::vector<int> randomData(size_t n, unsigned seed) {
+  std::mt19937 rng(seed);
+
+  std::vector<int> data(n);
+  for (auto &value : data)
+    value = static_cast<int>(rng());
+
+  return data;
+}
+
+void benchmarkMerge(size_t blockElements, size_t repeats) {
+  auto a = randomData(blockElements, 1);
+  auto b = randomData(blockElements, 2);
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+
+  std::vector<int> out(2 * blockElements);
+
+  for (Isa isa : {Isa::Scalar, Isa::Sse41, Isa::Avx2}) {
+    if (isa > utils::simd::detectIsa()) {
+      continue;
+    }
+
+    const auto start = Clock::now();
+
+    for (size_t r = 0; r < repeats; ++r) {
+      utils::simd::merge(a.data(), a.size(), b.data(), b.size(), out.data(),
+                         isa);
+    }
+
+    report(std::string("merge ") + utils::simd::isaName(isa),
+           out.size() * repeats, secondsSince(start));
+  }
+}
+
+void benchmarkSort(size_t chunkElements, size_t totalElements) {
+  const auto source = randomData(totalElements, 3);
+
+  for (Isa isa : {Isa::Scalar, Isa::Sse41, Isa::Avx2}) {
+    if (isa > utils::simd::detectIsa()) {
+      continue;
+    }
+
+    auto data = source;
+    const auto start = Clock::now();
+
+    for (size_t base = 0; base + chunkElements <= data.size();
+         base += chunkElements) {
+      utils::simd::sort(data.data() + base, chunkElements, isa);
+    }
+
+    report("sort chunks of " + std::to_string(chunkElements) + " " +
+               utils::simd::isaName(isa),
+           data.size(), secondsSince(start));
+  }
+}
+
+} // namespace
+
+/// Использование: SimdBenchmark [merge_block_elements] [sort_elements]
+int main(int argc, char *argv[]) {
+  const size_t blockElements =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096;
+  const size_t sortElements =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 16'000'000ULL;
+
+  std::cout << "detected: " << utils::simd::isaName(utils::simd::detectIsa())
+            << '\n';
+
+  benchmarkMerge(blockElements, sortElements / blockElements);
+
+  for (size_t chunk : {64u, 256u, 1024u}) {
+    benchmarkSort(chunk, sortElements);
+  }
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include "../include/entities/TapeSorter.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+#include "../include/entities/fileTapes/DirectFileTape.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void report(const std::string &name, size_t elements, double seconds) {
+  std::cout << name << ": " << elements << " elements, " << seconds << " s, "
+            << static_cast<double>(elements) / seconds / 1e6 << " M elem/s\n";
+}
+
+template <typename Tape>
+void benchmarkScan(const std::string &name, const std::string &filename,
+                   size_t tapeElements, size_t scanElements) {
+  const TapeConfig config{0, 0, 0, 0};
+
+  auto start = Clock::now();
+  Tape tape(filename, tapeElements * sizeof(int), config);
+
+  std::cout << name << ": opened tape of " << tape.getSize()
+            << " elements in " << secondsSince(start) << " s\n";
+
+  start = Clock::now();
+  long long checksum = 0;
+
+  for (size_t i = 0; i < scanElements && !tape.isAtEnd(); ++i) {
+    checksum += tape.read();
+    tape.moveRight();
+  }
+
+  report(name + " sequential read", scanElements, secondsSince(start));
+
+  if (checksum != 0) {
+    std::cout << "unexpected checksum " << checksum << '\n';
+  }
+}
+
+void benchmarkSort(const std::string &dir, size_t elements,
+                   size_t memoryLimit) {
+  const TapeConfig config{0, 0, 0, 0};
+  const std::string inputFile = dir + "/sort_input.bin";
+  const std::string outputFile = dir + "/sort_output.bin";
+
+  {
+    std::mt19937 rng(42);
+    std::ofstream file(inputFile, std::ios::binary);
+
+    for (size_t i = 0; i < elements; ++i) {
+      int value = static_cast<int>(rng());
+      file.write(reinterpret_cast<const char *>(&value), sizeof(int));
+    }
+  }
+
+  BinaryFileTape input(inputFile, elements * sizeof(int), config);
+  BinaryFileTape output(outputFile, elements * sizeof(int), config);
+
+  TapeSorter sorter(memoryLimit, config, dir + "/tmp");
+
+  auto start = Clock::now();
+  sorter.sort(input, output);
+
+  report("TapeSorter::sort", elements, secondsSince(start));
+}
+
+} // namespace
+
+/// Использование: TapeBenchmark [tape_elements] [scan_elements]
+/// [sort_elements] [work_dir]
+int main(int argc, char *argv[]) {
+  const size_t tapeElements =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000'000ULL;
+  const size_t scanElements =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20'000'000ULL;
+  const size_t sortElements =
+      argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 2'000'000ULL;
+  const std::string dir = argc > 4 ? argv[4] : "tape_benchmark_tmp";
+
+  fs::create_directories(dir);
+  const std::string sparseFile = dir + "/sparse.bin";
+
+  std::ofstream(sparseFile, std::ios::binary).close();
+  fs::resize_file(sparseFile, tapeElements * sizeof(int));
+
+  benchmarkScan<BinaryFileTape>("BinaryFileTape", sparseFile, tapeElements,
+                                scanElements);
+
+  if (DirectFileTape::isSupported()) {
+    benchmarkScan<DirectFileTape>("DirectFileTape", sparseFile, tapeElements,
+                                  scanElements);
+  }
+
+  benchmarkSort(dir, sortElements, sortElements / 16 * sizeof(int));
+
+  fs::remove_all(dir);
+  return 0;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../entities/TapeConfig.h"
+#include "../interfaces/TapeInterface.h"
+#include "TapeDrive.h"
+#include "TapeScheduler.h"
+
+#include <coroutine>
+#include <memory>
+#include <utility>
+
+/// @brief Асинхронная обёртка над лентой: `co_await tape.read()`
+/// приостанавливает сопрограмму на время задержки привода. Сама обёрнутая
+/// лента должна работать без задержек (или со своими, если они уже
+/// учтены), задержки привода моделирует планировщик.
+class AsyncTape {
+public:
+  /// @brief Лента на собственном приводе с задержками delays.
+  AsyncTape(TapeScheduler &scheduler, TapeInterface &tape,
+            const TapeConfig &delays);
+
+  /// @brief Лента на общем приводе: операции всех его лент сериализуются.
+  AsyncTape(TapeDrive &drive, TapeInterface &tape);
+
+  template <typename Operation> class Awaiter {
+  public:
+    Awaiter(TapeDrive &drive, int delay, Operation operation)
+        : m_drive(drive), m_delay(delay), m_operation(std::move(operation)) {}
+
+    bool await_ready() const noexcept {
+      return m_delay <= 0 &&
+             m_drive.getBusyUntil() <= m_drive.getScheduler().now();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      m_drive.getScheduler().schedule(handle, m_drive.reserve(m_delay));
+    }
+
+    auto await_resume() { return m_operation(); }
+
+  private:
+    TapeDrive &m_drive;
+    int m_delay;
+    Operation m_operation;
+  };
+
+  auto read() {
+    return makeAwaiter(delays().readDelay, [this] { return m_tape.read(); });
+  }
+
+  auto write(int data) {
+    return makeAwaiter(delays().writeDelay,
+                       [this, data] { m_tape.write(data); });
+  }
+
+  auto moveLeft() {
+    return makeAwaiter(delays().shiftDelay, [this] { m_tape.moveLeft(); });
+  }
+
+  auto moveRight() {
+    return makeAwaiter(delays().shiftDelay, [this] { m_tape.moveRight(); });
+  }
+
+  auto rewind() {
+    return makeAwaiter(delays().rewindDelay, [this] { m_tape.rewind(); });
+  }
+
+  /// @brief Запись в фоне, как у привода с буфером записи: значение сразу
+  /// попадает на ленту, привод занят записью после своей очереди, а
+  /// сопрограмма не ждёт его. Следующие операции ленты, в том числе чтение,
+  /// встают в очередь привода за ней.
+  void writeBehind(int data);
+
+  /// @brief Сдвиг вправо в фоне, как writeBehind.
+  void moveRightBehind();
+
+  /// @brief Дождаться, пока привод выполнит всю свою очередь.
+  auto drain() { return makeAwaiter(0, [] {}); }
+
+  bool isAtEnd() const;
+
+  size_t getSize() const;
+
+  /// @brief Момент, когда привод ленты освободится.
+  TapeScheduler::Milliseconds getBusyUntil() const;
+
+  TapeDrive &getDrive() const;
+
+private:
+  std::unique_ptr<TapeDrive> m_ownDrive;
+  TapeDrive &m_drive;
+  TapeInterface &m_tape;
+
+  const TapeConfig &delays() const { return m_drive.getDelays(); }
+
+  template <typename Operation>
+  Awaiter<Operation> makeAwaiter(int delay, Operation operation) {
+    return Awaiter<Operation>(m_drive, delay, std::move(operation));
+  }
+};
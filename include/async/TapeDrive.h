@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../entities/TapeConfig.h"
+#include "TapeScheduler.h"
+
+/// @brief Физический привод: операции всех привязанных к нему лент
+/// выполняются строго по очереди, а разные приводы работают параллельно.
+class TapeDrive {
+public:
+  TapeDrive(TapeScheduler &scheduler, const TapeConfig &delays);
+
+  TapeScheduler &getScheduler() const;
+
+  const TapeConfig &getDelays() const;
+
+  /// @brief Момент, когда привод освободится.
+  TapeScheduler::Milliseconds getBusyUntil() const;
+
+  /// @brief Занимает привод на delay миллисекунд после текущей очереди и
+  /// возвращает момент завершения операции.
+  TapeScheduler::Milliseconds reserve(int delay);
+
+private:
+  TapeScheduler &m_scheduler;
+  TapeConfig m_delays;
+
+  TapeScheduler::Milliseconds m_busyUntil = 0;
+};
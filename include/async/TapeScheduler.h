@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Task.h"
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+/// @brief Однопоточный планировщик сопрограмм, работающих с лентами.
+/// Операция ленты не блокирует поток: сопрограмма приостанавливается до
+/// момента, когда привод завершит операцию, а тем временем выполняются
+/// сопрограммы других лент. Время отсчитывается в миллисекундах от
+/// создания планировщика; в режиме realTime планировщик дожидается этого
+/// момента по настенным часам, иначе время только моделируется.
+class TapeScheduler {
+public:
+  using Milliseconds = std::int64_t;
+
+  explicit TapeScheduler(bool realTime = true);
+
+  /// @brief Забирает задачу и ставит её на запуск в текущий момент.
+  void spawn(Task task);
+
+  /// @brief Выполняет все задачи до завершения и пробрасывает первую
+  /// возникшую в них ошибку.
+  void run();
+
+  /// @brief Возобновить handle в момент at.
+  void schedule(std::coroutine_handle<> handle, Milliseconds at);
+
+  Milliseconds now() const;
+
+private:
+  struct Timer {
+    Milliseconds at;
+    std::uint64_t sequence;
+    std::coroutine_handle<> handle;
+
+    bool operator>(const Timer &other) const {
+      return at != other.at ? at > other.at : sequence > other.sequence;
+    }
+  };
+
+  bool m_realTime;
+  std::chrono::steady_clock::time_point m_start;
+
+  Milliseconds m_now = 0;
+  std::uint64_t m_sequence = 0;
+
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>>
+      m_timers;
+  std::vector<Task> m_tasks;
+};
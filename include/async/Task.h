@@ -0,0 +1,86 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+/// @brief Ленивая сопрограмма без результата. Запускается планировщиком
+/// (TapeScheduler::spawn) или через co_await из другой сопрограммы.
+class Task {
+public:
+  struct promise_type {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    auto final_suspend() noexcept {
+      struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+          auto continuation = handle.promise().continuation;
+          return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+      };
+
+      return FinalAwaiter{};
+    }
+
+    void return_void() {}
+
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+
+  Task(Task &&other) noexcept
+      : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      if (m_handle)
+        m_handle.destroy();
+      m_handle = std::exchange(other.m_handle, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  ~Task() {
+    if (m_handle)
+      m_handle.destroy();
+  }
+
+  bool done() const { return !m_handle || m_handle.done(); }
+
+  std::coroutine_handle<> handle() const { return m_handle; }
+
+  void rethrowIfFailed() const {
+    if (m_handle && m_handle.promise().error)
+      std::rethrow_exception(m_handle.promise().error);
+  }
+
+  bool await_ready() const noexcept { return done(); }
+
+  std::coroutine_handle<>
+  await_suspend(std::coroutine_handle<> continuation) noexcept {
+    m_handle.promise().continuation = continuation;
+    return m_handle;
+  }
+
+  void await_resume() const { rethrowIfFailed(); }
+
+private:
+  explicit Task(std::coroutine_handle<promise_type> handle)
+      : m_handle(handle) {}
+
+  std::coroutine_handle<promise_type> m_handle;
+};
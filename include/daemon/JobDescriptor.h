@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../entities/TapeSorter.h"
+
+#include <cstddef>
+#include <string>
+
+/// @brief Задание на сортировку из файла <имя>.job в каталоге очереди.
+///
+/// Формат совпадает с конфигурационным файлом: строки `ключ = значение`,
+/// комментарии начинаются с '#'. Обязательны `input` и `output`;
+/// `memory_limit` (байты, 0 — лимит демона), `top_k` и `merge_strategy`
+/// (pairwise|backward|async|forecast) необязательны.
+struct JobDescriptor {
+  std::string name;
+
+  std::string inputFile;
+  std::string outputFile;
+
+  size_t memoryLimit = 0;
+  size_t topK = 0;
+  MergeStrategy mergeStrategy = MergeStrategy::Pairwise;
+};
+
+/// @brief Читает описание задания; name берётся из имени файла без
+/// расширения. Бросает std::runtime_error при ошибке формата.
+JobDescriptor parseJobDescriptor(const std::string &path);
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+/// @brief Общий для всех рабочих потоков бюджет ресурса (памяти или места
+/// под временные файлы). acquire() блокируется, пока не освободится нужный
+/// объём, поэтому одновременные задания в сумме не превышают бюджет.
+class ResourceBudget {
+public:
+  explicit ResourceBudget(size_t capacity);
+
+  /// @brief Резервирует amount; бросает std::invalid_argument, если amount
+  /// больше всего бюджета.
+  void acquire(size_t amount);
+
+  void release(size_t amount);
+
+  size_t getCapacity() const;
+
+  size_t getAvailable() const;
+
+  /// @brief Резерв, освобождаемый при выходе из области видимости.
+  class Lease {
+  public:
+    Lease(ResourceBudget &budget, size_t amount);
+    ~Lease();
+
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+  private:
+    ResourceBudget &m_budget;
+    size_t m_amount;
+  };
+
+private:
+  const size_t m_capacity;
+  size_t m_available;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_released;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../entities/SortStats.h"
+#include "../entities/TapeConfig.h"
+#include "JobDescriptor.h"
+#include "ResourceBudget.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct DaemonOptions {
+  /// Каталог очереди: сюда кладутся файлы <имя>.job.
+  std::string spoolDir;
+  /// Каталог для временных лент. Каждый демон занимает в нём свой
+  /// подкаталог daemon_<случайное число>, а в нём у каждого рабочего свой.
+  std::string tmpDir = "tmp_daemon";
+
+  size_t workers = 2;
+  /// Суммарная память буферов всех одновременно идущих заданий, байты.
+  size_t memoryBudget = 64 * 1024 * 1024;
+  /// Суммарный объём временных файлов всех заданий, байты.
+  size_t tempDiskBudget = 1024ull * 1024 * 1024;
+
+  std::chrono::milliseconds pollInterval{200};
+};
+
+/// @brief Метрики одного задания; дублируются в файл <имя>.done или
+/// <имя>.failed в каталоге очереди.
+struct JobMetrics {
+  std::string name;
+  bool succeeded = false;
+  std::string error;
+
+  size_t elements = 0;
+  size_t memoryBytes = 0;
+  size_t tempDiskBytes = 0;
+
+  /// Ожидание ресурсов после захвата задания, мс.
+  int64_t waitMs = 0;
+  /// Время самой сортировки, мс.
+  int64_t runMs = 0;
+
+  SortStats stats;
+};
+
+/// @brief Долгоживущий сервис сортировки: забирает задания из каталога
+/// очереди и выполняет их на пуле рабочих потоков в пределах общего
+/// бюджета памяти и места под временные файлы. У каждого рабочего свой
+/// TapeSorter, поэтому буфер серий переиспользуется между заданиями.
+///
+/// Задание захватывается атомарным переименованием <имя>.job в
+/// <имя>.running, так что несколько демонов могут делить один каталог.
+class SortDaemon {
+public:
+  SortDaemon(TapeConfig config, DaemonOptions options);
+  ~SortDaemon();
+
+  SortDaemon(const SortDaemon &) = delete;
+  SortDaemon &operator=(const SortDaemon &) = delete;
+
+  /// @brief Захватывает все новые задания из каталога очереди и ставит их в
+  /// очередь рабочих. Возвращает число захваченных заданий.
+  size_t poll();
+
+  /// @brief Блокируется, пока очередь не опустеет и все задания не
+  /// завершатся.
+  void waitIdle();
+
+  /// @brief Опрашивает каталог очереди каждые pollInterval, пока
+  /// shouldStop() не вернёт true, затем дожидается текущих заданий.
+  void serve(const std::function<bool()> &shouldStop);
+
+  /// @brief Вызывается из рабочего потока после каждого задания.
+  void setJobCallback(std::function<void(const JobMetrics &)> callback);
+
+  std::vector<JobMetrics> getMetrics() const;
+
+private:
+  const TapeConfig m_config;
+  const DaemonOptions m_options;
+
+  ResourceBudget m_memory;
+  ResourceBudget m_tempDisk;
+
+  std::deque<std::string> m_queue;
+  size_t m_active = 0;
+  bool m_stopping = false;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_jobAvailable;
+  std::condition_variable m_idle;
+
+  std::vector<JobMetrics> m_metrics;
+  std::function<void(const JobMetrics &)> m_callback;
+
+  /// Подкаталог m_options.tmpDir, принадлежащий только этому демону.
+  std::string m_tmpDir;
+
+  std::vector<std::thread> m_workers;
+
+  /// @brief Атомарно создаёт в m_options.tmpDir ещё не занятый
+  /// подкаталог, чтобы демоны с общим каталогом не удаляли чужие ленты.
+  static std::string claimTmpDir(const std::string &parent);
+
+  void workerLoop(size_t index);
+
+  JobMetrics runJob(TapeSorter &sorter, const std::string &claimedPath);
+
+  /// @brief Верхняя оценка объёма временных файлов: серии и все
+  /// промежуточные уровни попарного слияния до удаления каталога.
+  static size_t estimateTempDisk(size_t elements, size_t memoryLimit);
+
+  void report(const std::string &claimedPath, const JobMetrics &metrics);
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/// @brief Потоковый квантильный эскиз KLL (Karnin, Lang, Liberty, 2016).
+/// Элементы копятся в уровнях; уровень h хранит элементы с весом 2^h, и
+/// переполненный уровень сортируется, а каждый второй его элемент (со
+/// случайным сдвигом) уходит уровнем выше. Ёмкость уровней убывает вниз в
+/// 2/3 раза от k, поэтому память — O(k) при ошибке ранга порядка 1.7 / k.
+class KllSketch {
+public:
+  explicit KllSketch(size_t k = 200, uint64_t seed = 1);
+
+  void add(int value);
+
+  size_t getCount() const;
+
+  /// @brief Сколько элементов эскиз хранит сейчас.
+  size_t getRetained() const;
+
+  int getMin() const;
+
+  int getMax() const;
+
+  /// @brief Приближённый q-квантиль, q из [0, 1]: 0 — минимум, 1 —
+  /// максимум. У пустого эскиза бросает std::logic_error.
+  int quantile(double q) const;
+
+  /// @brief Приближённое число добавленных элементов, не больших value.
+  size_t rank(int value) const;
+
+private:
+  size_t m_k;
+  std::vector<std::vector<int>> m_levels;
+  size_t m_count = 0;
+  size_t m_retained = 0;
+  // Суммарная ёмкость уровней: пересчитывается при появлении уровня.
+  size_t m_limit = 0;
+  int m_min = 0;
+  int m_max = 0;
+  std::mt19937_64 m_random;
+
+  size_t capacity(size_t level) const;
+
+  void compress();
+};
+
+/// @brief Гистограмма с bins корзинами равной ширины за один проход без
+/// знания диапазона заранее. Корзины выровнены по кратным ширины и
+/// начинаются у минимума; если диапазон значений не помещается в корзины,
+/// ширина удваивается и соседние корзины сливаются, поэтому счётчики
+/// остаются точными, а корзины покрывают не больше удвоенного диапазона.
+class EquiWidthHistogram {
+public:
+  explicit EquiWidthHistogram(size_t bins);
+
+  void add(int value, size_t count = 1);
+
+  /// @brief Левая граница первой корзины; корзина i — [low + i * width,
+  /// low + (i + 1) * width).
+  int64_t getLow() const;
+
+  int64_t getWidth() const;
+
+  const std::vector<size_t> &getCounts() const;
+
+private:
+  int64_t m_low = 0;
+  int64_t m_width = 1;
+  int m_min = 0;
+  int m_max = 0;
+  std::vector<size_t> m_counts;
+  bool m_empty = true;
+
+  void widen();
+};
+
+/// @brief Квантили и гистограмма входа, собранные при его чтении.
+struct DataSketch {
+  explicit DataSketch(size_t histogramBins) : histogram(histogramBins) {}
+
+  void add(int value) {
+    quantiles.add(value);
+    histogram.add(value);
+  }
+
+  KllSketch quantiles;
+  EquiWidthHistogram histogram;
+};
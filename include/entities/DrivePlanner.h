@@ -0,0 +1,53 @@
+#pragma once
+
+#include "TapeConfig.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Слияние двух серий, назначенное на шаг уровня.
+struct PlannedMerge {
+  size_t first;
+  size_t second;
+  size_t outputDrive;
+};
+
+/// @brief Серия на приводе: индекс привода и длина в элементах.
+struct PlacedRun {
+  size_t drive;
+  size_t length;
+};
+
+/// @brief Планирует размещение серий и слияний по приводам из
+/// TapeConfig::drives. Внутри одного шага ни один привод не читается и не
+/// пишется одновременно, а выходная лента слияния ставится на привод с
+/// наименьшей оценённой занятостью, поэтому быстрые приводы получают больше
+/// работы, а медленные не простаивают.
+class DrivePlanner {
+public:
+  explicit DrivePlanner(std::vector<DriveConfig> drives);
+
+  /// @brief Выбирает привод для новой серии длины length.
+  size_t placeRun(size_t length);
+
+  /// @brief Разбивает один уровень попарного слияния runs на шаги. Серии,
+  /// не попавшие ни в одно слияние, переходят на следующий уровень как есть.
+  std::vector<std::vector<PlannedMerge>>
+  planLevel(const std::vector<PlacedRun> &runs);
+
+  size_t getDriveCount() const;
+
+  /// @brief Оценка суммарного времени работы привода в миллисекундах.
+  int64_t getLoad(size_t drive) const;
+
+private:
+  std::vector<DriveConfig> m_drives;
+  std::vector<int64_t> m_loads;
+
+  int64_t readCost(size_t drive, size_t length) const;
+  int64_t writeCost(size_t drive, size_t length) const;
+
+  size_t cheapestDrive(size_t length,
+                       const std::vector<bool> &excluded) const;
+};
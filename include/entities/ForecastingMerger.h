@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../interfaces/TapeInterface.h"
+
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <vector>
+
+/// @brief K-путевое слияние с прогнозированием (Кнут, т. 3, 5.4.6). Каждый
+/// вход читается блоками по blockElements элементов, и на все входы есть
+/// один запасной блок. Первым опустеет блок, у которого наименьший
+/// последний ключ, поэтому в запасной блок заранее, в фоновом потоке,
+/// читается следующий блок именно этого входа, пока слияние продолжает
+/// писать в выход. Память — (K + 1) блоков.
+class ForecastingMerger {
+public:
+  /// @brief Входы должны стоять в начале и быть отсортированы по
+  /// возрастанию; они не должны использоваться до конца merge().
+  ForecastingMerger(std::vector<TapeInterface *> inputs, size_t blockElements);
+
+  ~ForecastingMerger();
+
+  ForecastingMerger(const ForecastingMerger &) = delete;
+  ForecastingMerger &operator=(const ForecastingMerger &) = delete;
+
+  /// @brief Пишет в output не более limit наименьших элементов входов с
+  /// текущей позиции output. Возвращает число записанных элементов.
+  size_t merge(TapeInterface &output,
+               size_t limit = std::numeric_limits<size_t>::max());
+
+  /// @brief Сколько блоков прочитано заранее в запасной буфер.
+  size_t getPrefetched() const;
+
+  /// @brief Сколько раз опустел не тот блок, что был спрогнозирован, и
+  /// следующий блок читался синхронно.
+  size_t getMisses() const;
+
+private:
+  struct Input {
+    TapeInterface *tape;
+    size_t remaining;
+    std::vector<int> block;
+    size_t pos = 0;
+  };
+
+  static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+  std::vector<Input> m_inputs;
+  size_t m_blockElements;
+
+  std::vector<int> m_spare;
+  size_t m_spareOwner = kNone;
+  std::future<void> m_prefetch;
+
+  size_t m_prefetched = 0;
+  size_t m_misses = 0;
+
+  static void readBlock(Input &input, std::vector<int> &block,
+                        size_t blockElements);
+
+  void startPrefetch();
+  void refill(size_t index);
+};
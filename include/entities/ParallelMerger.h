@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+/// @brief Отсортированная серия с произвольным доступом к элементам.
+struct SortedRun {
+  size_t size;
+  std::function<int(size_t)> at;
+};
+
+/// @brief Параллельное K-путевое слияние файлов серий (merge path). Выход
+/// делится на threads диапазонов равной длины, границы диапазонов во
+/// входах находит coRank, и каждый поток сливает свой диапазон в свой
+/// участок выходного файла позиционной записью. Работает с файлами
+/// BinaryFileTape напрямую, без эмуляции задержек ленты.
+class ParallelMerger {
+public:
+  /// @brief bufferElements — размер буфера чтения каждого входа и буфера
+  /// записи в каждом потоке.
+  ParallelMerger(std::vector<std::string> inputs, size_t threads,
+                 size_t bufferElements);
+
+  /// @brief Пишет не более limit наименьших элементов входов в начало
+  /// файла output, при необходимости увеличивая его. Возвращает число
+  /// записанных элементов.
+  size_t merge(const std::string &output,
+               size_t limit = std::numeric_limits<size_t>::max()) const;
+
+  /// @brief Для каждой серии — сколько её элементов входит в первые rank
+  /// элементов слияния. Из равных элементов раньше идут элементы серий с
+  /// меньшим номером, поэтому границы соседних диапазонов согласованы.
+  static std::vector<size_t> coRank(const std::vector<SortedRun> &runs,
+                                    size_t rank);
+
+private:
+  std::vector<std::string> m_inputs;
+  size_t m_threads;
+  size_t m_bufferElements;
+
+  void mergeRange(const std::vector<size_t> &begin,
+                  const std::vector<size_t> &end, size_t offset,
+                  const std::string &output) const;
+};
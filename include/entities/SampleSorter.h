@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../interfaces/TapeInterface.h"
+#include "../trace/TraceRecorder.h"
+#include "SortStats.h"
+#include "TapeConfig.h"
+#include "TapeSorter.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief Параллельная внешняя сортировка с разбиением по диапазонам
+/// (sample sort). Вход делится на partitions корзин по сплиттерам, выбранным
+/// из выборки, и каждая корзина сортируется своим TapeSorter в отдельном
+/// потоке, поэтому глобальное слияние не требуется.
+class SampleSorter {
+public:
+  SampleSorter(size_t memoryLimit, TapeConfig config, size_t partitions,
+               std::string workDir = "tmp_sample");
+
+  /// @brief Сортирует input и склеивает отсортированные корзины в output.
+  void sort(TapeInterface &input, TapeInterface &output);
+
+  /// @brief Сортирует input, оставляя результат в виде файлов
+  /// outputPrefix_<i>.bin; конкатенация файлов по порядку даёт
+  /// отсортированную последовательность.
+  std::vector<std::string> sortToPartitions(TapeInterface &input,
+                                            const std::string &outputPrefix);
+
+  /// @brief Стратегия слияния для сортировщиков корзин.
+  void setMergeStrategy(MergeStrategy strategy);
+
+  /// @brief Записывать операции корзин и временных лент в recorder
+  /// (nullptr — отключить). Входную и выходную ленты вызывающий оборачивает
+  /// сам.
+  void setTraceRecorder(TraceRecorder *recorder);
+
+  /// @brief Суммарная статистика сортировщиков корзин за последний вызов;
+  /// countingSort — если хотя бы одна корзина отсортирована подсчётом.
+  const SortStats &getStats() const;
+
+private:
+  static constexpr size_t kOversampling = 16;
+
+  size_t m_memoryLimit;
+  size_t m_maxElements;
+  size_t m_partitions;
+
+  const TapeConfig m_config;
+
+  MergeStrategy m_strategy = MergeStrategy::Pairwise;
+  SortStats m_stats;
+  TraceRecorder *m_traceRecorder = nullptr;
+
+  const std::string m_workDir;
+
+  std::unique_ptr<TapeInterface>
+  traced(std::unique_ptr<TapeInterface> tape) const;
+
+  std::vector<int> chooseSplitters(TapeInterface &input) const;
+
+  std::vector<std::unique_ptr<TapeInterface>>
+  partition(TapeInterface &input, const std::vector<int> &splitters) const;
+
+  std::vector<std::unique_ptr<TapeInterface>>
+  sortBuckets(std::vector<std::unique_ptr<TapeInterface>> &buckets,
+              const std::vector<std::string> &outputFiles, bool directIo,
+              Durability durability);
+
+  std::vector<std::unique_ptr<TapeInterface>>
+  run(TapeInterface &input, const std::vector<std::string> &outputFiles,
+      bool directIo, Durability durability);
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../interfaces/TapeInterface.h"
+
+#include <cstddef>
+#include <functional>
+
+/// @brief Операция над двумя лентами, отсортированными по возрастанию.
+/// Ленты — мультимножества: если ключ встречается a раз в левой ленте и
+/// b раз в правой, в выход он попадает столько раз, сколько указано ниже.
+enum class SetOperation {
+  /// max(a, b) раз.
+  Union,
+  /// min(a, b) раз.
+  Intersection,
+  /// Левая без правой: max(a - b, 0) раз.
+  Difference,
+  /// a + b раз, как в слиянии.
+  Merge,
+};
+
+/// @brief Счётчики последнего запуска SetOperations.
+struct SetOperationStats {
+  size_t written = 0;
+  /// Сравнений ключей: галоп уменьшает их, когда одна лента намного
+  /// короче другой.
+  size_t comparisons = 0;
+};
+
+/// @brief Потоковые операции над парой отсортированных лент. Ядро то же,
+/// что у слияния mergeTwo: головы лент сравниваются, и меньшая
+/// продвигается, поэтому каждая лента перематывается один раз и читается
+/// за один последовательный проход.
+///
+/// Ленты читаются блоками в буферы из памяти memoryLimit. С галопом
+/// элементы, которые нужно пропустить до ключа другой ленты, ищутся в
+/// блоке экспоненциальным поиском, а не по одному: если одна лента
+/// намного короче, длинная пропускается за логарифм сравнений на ключ
+/// короткой.
+class SetOperations {
+public:
+  /// @brief Вызывается для каждого ключа, который есть в обеих лентах, с
+  /// числом его вхождений в левую и правую ленты.
+  using JoinVisitor =
+      std::function<void(int key, size_t leftCount, size_t rightCount)>;
+
+  explicit SetOperations(size_t memoryLimit, bool gallop = false);
+
+  /// @brief Пишет результат операции в output с начала ленты. Возвращает
+  /// число записанных элементов.
+  size_t apply(SetOperation operation, TapeInterface &left,
+               TapeInterface &right, TapeInterface &output);
+
+  /// @brief Соединение слиянием: visit для каждого общего ключа по
+  /// возрастанию. Возвращает число таких ключей.
+  size_t join(TapeInterface &left, TapeInterface &right,
+              const JoinVisitor &visit);
+
+  const SetOperationStats &getStats() const;
+
+private:
+  size_t m_blockElements;
+  bool m_gallop;
+
+  SetOperationStats m_stats;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+/// @brief Порядок сортировки как политика времени компиляции для
+/// BasicTapeSorter: Compare — строгий слабый порядок на int, Stable —
+/// элементы, равные по Compare, сохраняют порядок входа. Сравнение
+/// подставляется в код сортировки и слияний, поэтому у обычного
+/// возрастающего порядка нет косвенных вызовов.
+template <typename Compare, bool Stable = false> struct SortOrder {
+  using Comparator = Compare;
+
+  static constexpr bool kStable = Stable;
+
+  static bool less(int a, int b) { return Compare{}(a, b); }
+};
+
+/// @brief Сравнение по модулю: -3 и 3 равны, поэтому устойчивость видна
+/// на выходе. Пример пользовательского компаратора, для которого
+/// сортировка подсчётом и векторные ядра не применяются.
+struct MagnitudeLess {
+  bool operator()(int a, int b) const {
+    const auto magnitude = [](int x) {
+      return x < 0 ? -static_cast<int64_t>(x) : static_cast<int64_t>(x);
+    };
+
+    return magnitude(a) < magnitude(b);
+  }
+};
+
+using Ascending = SortOrder<std::less<int>>;
+using Descending = SortOrder<std::greater<int>>;
+using ByMagnitude = SortOrder<MagnitudeLess>;
+using StableByMagnitude = SortOrder<MagnitudeLess, true>;
+
+/// @brief Compare различает любые два разных int. Тогда равные элементы
+/// неотличимы, устойчивость ничего не меняет, и применима сортировка
+/// подсчётом.
+template <typename Compare>
+inline constexpr bool isTotalOrder =
+    std::is_same_v<Compare, std::less<int>> ||
+    std::is_same_v<Compare, std::greater<int>>;
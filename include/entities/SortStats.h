@@ -0,0 +1,23 @@
+#pragma once
+
+#include "DataSketch.h"
+#include "SortVerification.h"
+
+#include <cstddef>
+#include <optional>
+
+/// @brief Счётчики последнего запуска TapeSorter.
+struct SortStats {
+  size_t runs = 0;
+  size_t mergePasses = 0;
+  size_t rewinds = 0;
+  /// Элементов записано слияниями, включая выходную ленту: объём
+  /// пересылок, который минимизирует порядок слияний.
+  size_t mergedElements = 0;
+  /// Вход отсортирован подсчётом без временных лент.
+  bool countingSort = false;
+  /// Квантили и гистограмма входа, если TapeSorter::setSketch включил их.
+  std::optional<DataSketch> sketch;
+  /// Итог проверки выхода, если TapeSorter::setVerify включил её.
+  std::optional<SortVerification> verification;
+};
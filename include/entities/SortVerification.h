@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../interfaces/TapeInterface.h"
+#include "SortOrder.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Контрольная сумма мультимножества элементов, не зависящая от их
+/// порядка: сумма по модулю 2^64 перемешанных хешем значений и их число.
+/// В отличие от XOR, парные повторы не взаимоуничтожаются.
+struct Checksum {
+  size_t count = 0;
+  uint64_t sum = 0;
+
+  void add(int value, size_t times = 1);
+
+  bool operator==(const Checksum &other) const = default;
+};
+
+/// @brief Строгий порядок, по которому проверяется выход.
+using OrderLess = bool (*)(int, int);
+
+/// @brief Итог проверки сортировки: выход упорядочен и содержит те же
+/// элементы, что и вход.
+struct SortVerification {
+  Checksum input;
+  Checksum output;
+  bool sorted = true;
+  /// Позиция первого элемента выхода, идущего по порядку раньше
+  /// предыдущего.
+  size_t firstUnsorted = 0;
+
+  bool ok() const { return sorted && input == output; }
+};
+
+/// @brief Декоратор выходной ленты, который по ходу записи считает
+/// контрольную сумму и проверяет порядок. Выход пишется последовательно
+/// от начала; перемотка начинает проверку заново, а запись не в следующую
+/// позицию считается ошибкой сортировщика.
+class VerifyingTape : public TapeInterface {
+public:
+  explicit VerifyingTape(TapeInterface &tape,
+                         OrderLess less = &Ascending::less);
+
+  int read() final;
+
+  void write(int data) final;
+
+  void moveLeft() final;
+
+  void moveRight() final;
+
+  void rewind() final;
+
+  bool isAtEnd() const final;
+
+  size_t getSize() const final;
+
+  void sync() final;
+
+  /// @brief Переносит в result контрольную сумму и порядок записанного.
+  void report(SortVerification &result) const;
+
+private:
+  TapeInterface &m_tape;
+  OrderLess m_less;
+
+  Checksum m_checksum;
+  int m_last = 0;
+  bool m_sorted = true;
+  size_t m_firstUnsorted = 0;
+
+  size_t m_position = 0;
+};
+
+/// @brief Проверка готового выхода без сортировки: один проход по output
+/// и, если задан, один проход по input для сравнения контрольных сумм.
+/// Без input проверяется только порядок.
+SortVerification verifySorted(TapeInterface &output,
+                              TapeInterface *input = nullptr,
+                              OrderLess less = &Ascending::less);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "SortStats.h"
+#include "TapeConfig.h"
+#include "TapeSorter.h"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <utility>
+
+/// @brief Сортировка в памяти процесса без промежуточных входных и выходных
+/// файлов. Вход — диапазон, генератор или std::istream, выход — итератор
+/// вывода или callback. Внутри используется TapeSorter поверх
+/// GeneratorTape/CallbackTape: если данные помещаются в memoryLimit,
+/// временные файлы не создаются, иначе серии сбрасываются на диск в tmpDir.
+class StreamSorter {
+public:
+  using Generator = std::function<std::optional<int>()>;
+  using Sink = std::function<void(int)>;
+
+  StreamSorter(size_t memoryLimit, TapeConfig config = {},
+               std::string tmpDir = "tmp_stream");
+
+  void sort(const Generator &source, const Sink &sink);
+
+  /// @brief Читает целые числа, разделённые пробельными символами, до конца
+  /// потока. Бросает std::runtime_error на нечисловых данных.
+  void sort(std::istream &input, const Sink &sink);
+
+  template <std::ranges::input_range Range>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, int>
+  void sort(Range &&range, const Sink &sink) {
+    auto it = std::ranges::begin(range);
+    const auto end = std::ranges::end(range);
+
+    sort(
+        [&]() -> std::optional<int> {
+          if (it == end) {
+            return std::nullopt;
+          }
+
+          return static_cast<int>(*it++);
+        },
+        sink);
+  }
+
+  template <std::ranges::input_range Range, std::output_iterator<int> Out>
+    requires std::convertible_to<std::ranges::range_reference_t<Range>, int>
+  Out sort(Range &&range, Out out) {
+    sort(std::forward<Range>(range), [&out](int value) { *out++ = value; });
+    return out;
+  }
+
+  const SortStats &getStats() const;
+
+private:
+  TapeSorter m_sorter;
+};
@@ -1,6 +1,34 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+/// @brief Задержки одного физического привода.
+struct DriveConfig {
+  int readDelay = 0;
+  int writeDelay = 0;
+  int rewindDelay = 0;
+  int shiftDelay = 0;
+};
+
+/// @brief Как выбирать каталог для очередной временной ленты.
+enum class TempPlacement {
+  /// Каталоги по очереди.
+  RoundRobin,
+  /// Каталог с наибольшим свободным местом на диске.
+  FreeSpace,
+};
+
+/// @brief Что лента гарантирует в точке синхронизации (TapeInterface::sync).
+/// Между точками записи копятся в буфере и уходят в файл пачкой.
+enum class Durability {
+  /// Ничего: данные попадут в файл при вытеснении буфера или закрытии.
+  None,
+  /// Буфер сбрасывается в файл (в страничный кэш ОС).
+  Flush,
+  /// Буфер сбрасывается, и файл фиксируется на диске через fsync.
+  Fsync,
+};
 
 struct TapeConfig {
   int readDelay = 0;
@@ -8,4 +36,23 @@ struct TapeConfig {
   int rewindDelay = 0;
   int shiftDelay = 0;
   size_t memoryLimit = 1024;
+
+  // Ленты каждой роли можно открыть через DirectFileTape (O_DIRECT).
+  bool inputDirectIo = false;
+  bool tempDirectIo = false;
+  bool outputDirectIo = false;
+
+  // Приводы для временных лент. Пусто — каждая временная лента считается
+  // отдельным приводом с задержками из полей выше.
+  std::vector<DriveConfig> drives = {};
+
+  // Каталоги временных лент, обычно по одному на диск. Пусто — все
+  // временные ленты в каталоге TapeSorter.
+  std::vector<std::string> tempDirs = {};
+  TempPlacement tempPlacement = TempPlacement::RoundRobin;
+
+  // Надёжность по ролям: временные ленты живут до конца сортировки и
+  // синхронизируются на границах серий, выход — по завершении.
+  Durability tempDurability = Durability::None;
+  Durability outputDurability = Durability::Flush;
 };
@@ -1,19 +1,124 @@
 #pragma once
 
 #include "../interfaces/TapeInterface.h"
+#include "SortOrder.h"
+#include "SortStats.h"
 #include "TapeConfig.h"
 
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-class TapeSorter {
+class TraceRecorder;
+
+enum class MergeStrategy {
+  /// Попарное слияние с перемоткой всех лент перед каждым слиянием.
+  Pairwise,
+  /// Серии пишутся попеременно по возрастанию и убыванию и читаются в
+  /// обратном направлении через moveLeft, поэтому проходы слияния идут
+  /// один за другим без перемоток.
+  ReadBackward,
+  /// Все слияния уровня выполняются одновременно как сопрограммы поверх
+  /// TapeScheduler: задержки разных лент перекрываются, и время уровня
+  /// определяется самой долгой лентой, а не суммой. Если в конфигурации
+  /// заданы приводы, слияния раскладываются по ним через DrivePlanner.
+  Async,
+  /// K-путевое слияние блоками с прогнозированием (ForecastingMerger):
+  /// лимит памяти делится на K + 1 блоков, и следующий блок входа, который
+  /// опустеет первым, читается в фоне, пока идёт запись выхода.
+  Forecast,
+};
+
+/// @brief Внешняя сортировка лент в порядке Order (см. SortOrder.h).
+/// Реализация — в TapeSorter.tpp (устанавливается вместе с заголовками);
+/// библиотека явно инстанцирует порядки из SortOrder.h, а для своего
+/// компаратора достаточно включить entities/TapeSorter.tpp в одну единицу
+/// трансляции и инстанцировать шаблон там.
+///
+/// Векторные ядра, сортировка подсчётом, ForecastingMerger и
+/// ParallelMerger работают только с возрастающим порядком (первые два —
+/// ещё и с убывающим); для остальных порядков используются обычные
+/// сортировка и попарное слияние.
+template <typename Order = Ascending> class BasicTapeSorter {
 public:
-  TapeSorter(size_t memoryLimit, TapeConfig config);
+  using Comparator = typename Order::Comparator;
+
+  /// @brief Если в config заданы tempDirs, временные ленты раскладываются
+  /// по подкаталогам tmpDir внутри каждого из них, иначе пишутся в tmpDir.
+  BasicTapeSorter(size_t memoryLimit, TapeConfig config,
+                  std::string tmpDir = "tmp");
 
   void sort(TapeInterface &input, TapeInterface &output);
 
+  /// @brief Записывает в output только k первых в порядке Order элементов
+  /// input. Если k помещается в память, вход читается один раз через
+  /// ограниченную кучу, иначе слияние прерывается после k элементов.
+  void sortTopK(TapeInterface &input, TapeInterface &output, size_t k);
+
+  /// @brief Сливает несколько уже отсортированных лент в output, минуя
+  /// splitAndSort. Если assumeSorted == false, каждая лента сначала
+  /// проверяется, и неотсортированные сортируются обычным путём.
+  void mergeSorted(const std::vector<TapeInterface *> &inputs,
+                   TapeInterface &output, bool assumeSorted = false);
+
+  /// @brief Стратегия слияния для sort(); sortTopK и mergeSorted всегда
+  /// используют попарное слияние. Устойчивые порядки сливают только
+  /// соседние серии и всегда используют попарное слияние, а Forecast
+  /// доступен только для возрастающего порядка.
+  void setMergeStrategy(MergeStrategy strategy);
+
+  /// @brief Меняет лимит памяти для следующих сортировок. Буфер серий
+  /// сохраняется между вызовами sort(), поэтому один TapeSorter можно
+  /// переиспользовать для потока заданий без повторных выделений.
+  void setMemoryLimit(size_t memoryLimit);
+
+  /// @brief Число потоков последнего слияния. Если оно больше одного, а
+  /// все сливаемые серии и output — BinaryFileTape, выход делится на
+  /// диапазоны, которые потоки сливают и пишут позиционно (ParallelMerger);
+  /// иначе слияние идёт по лентам как обычно.
+  void setMergeThreads(size_t threads);
+
+  /// @brief Собирать при sort() и sortTopK() квантильный эскиз и
+  /// гистограмму с histogramBins корзинами по элементам, которые сортировка
+  /// и так читает со входа; результат — в getStats().sketch. 0 — не
+  /// собирать.
+  void setSketch(size_t histogramBins);
+
+  /// @brief Проверять результат sort() без лишних проходов: контрольная
+  /// сумма входа считается при его чтении, а порядок и контрольная сумма
+  /// выхода — при записи финального слияния. Итог — в
+  /// getStats().verification; если проверка не прошла, sort() бросает
+  /// std::runtime_error. Выход оборачивается в VerifyingTape, поэтому
+  /// параллельное слияние и копирование файлов ядром при проверке не
+  /// применяются.
+  void setVerify(bool verify);
+
+  /// @brief Только эскиз: один проход чтения входа без записи и временных
+  /// лент.
+  DataSketch sketch(TapeInterface &input, size_t histogramBins);
+
+  /// @brief Записывать операции временных лент в recorder (nullptr —
+  /// отключить). Входную и выходную ленты вызывающий оборачивает сам.
+  void setTraceRecorder(TraceRecorder *recorder);
+
+  const SortStats &getStats() const;
+
 private:
+  static constexpr size_t kNoLimit = std::numeric_limits<size_t>::max();
+  /// Оценка памяти на одно различное значение в счётчиках countingSort:
+  /// ключ, счётчик и служебные поля узла дерева.
+  static constexpr size_t kCountEntryBytes =
+      sizeof(int) + sizeof(size_t) + 4 * sizeof(void *);
+  /// Длина выборки, по которой countingSort решает, строить ли счётчики.
+  static constexpr size_t kCountSample = 4096;
+  /// Наименьший блок слияния с прогнозированием: мельче блоки дают больше
+  /// фоновых чтений, чем выигрывают от большей степени слияния.
+  static constexpr size_t kMinForecastBlock = 64;
+
   size_t m_memoryLimit;
   size_t m_maxElements;
 
@@ -21,9 +126,131 @@ private:
 
   const std::string m_tmpDir;
 
+  /// Каталоги временных лент и номера их устройств: каталоги на одном
+  /// устройстве получают одинаковый номер.
+  std::vector<std::string> m_tempDirs;
+  std::vector<size_t> m_tempDevices;
+  size_t m_nextTempDir = 0;
+  std::unordered_map<const TapeInterface *, size_t> m_tempDirOf;
+
+  MergeStrategy m_strategy = MergeStrategy::Pairwise;
+
+  SortStats m_stats;
+
+  size_t m_nextDrive = 0;
+
+  std::vector<int> m_buffer;
+
+  /// m_buffer начинается с выборки, на которой countingSort отказался от
+  /// подсчёта, а вход стоит сразу за ней: первая серия продолжает
+  /// выборку, и вход не перематывается повторно.
+  bool m_sampled = false;
+
+  TraceRecorder *m_traceRecorder = nullptr;
+
+  size_t m_mergeThreads = 1;
+
+  size_t m_sketchBins = 0;
+
+  bool m_verify = false;
+
+  void runInTmpDir(const std::function<void()> &job);
+
+  /// @brief Создаёт временную ленту. inputs — ленты, которые будут
+  /// сливаться в неё: по возможности лента попадает на другое устройство.
+  std::unique_ptr<TapeInterface>
+  createTempTape(const std::string &name, size_t maxBytes,
+                 const std::vector<const TapeInterface *> &inputs = {});
+  std::unique_ptr<TapeInterface>
+  createTempTape(const std::string &name, size_t maxBytes,
+                 const TapeConfig &config,
+                 const std::vector<const TapeInterface *> &inputs = {});
+  size_t pickTempDir(const std::vector<const TapeInterface *> &inputs);
+  /// @brief Длина серии номер run для поуровневых стратегий: при
+  /// известном размере входа серии выравниваются, чтобы слияния одного
+  /// уровня занимали одинаковое время и короткая серия не переносилась.
+  size_t runLength(size_t inputSize, size_t run) const;
+  void writeRun(const std::vector<int> &run, TapeInterface &output,
+                size_t limit);
+
+  void rewindTape(TapeInterface &tape);
+  /// @brief Читает элемент входа под головкой и добавляет его в эскиз и
+  /// контрольную сумму, если они собираются.
+  int readInput(TapeInterface &input);
+  /// @brief Добавляет элемент входа в эскиз и контрольную сумму, если они
+  /// собираются.
+  void addInput(int value);
+  /// @brief Начинает чтение входа для серий: перематывает его, если нет
+  /// выборки m_sampled, иначе продолжает с места, где она оборвалась.
+  void beginInput(TapeInterface &input);
+  /// @brief Готовит m_buffer к новой серии: очищает его, если там не
+  /// лежит выборка m_sampled.
+  void beginRun();
+  bool isSorted(TapeInterface &tape);
+
+  /// @brief Сортировка подсчётом за одно чтение входа и одну запись выхода
+  /// без временных лент. Возвращает false (ничего не записав), если вход
+  /// помещается в память или различных значений больше, чем умещается в
+  /// m_memoryLimit. Решение принимается по выборке из kCountSample первых
+  /// элементов; при отказе по ней выборка остаётся в m_buffer
+  /// (m_sampled), и обычный путь продолжает чтение без перемотки.
+  bool countingSort(TapeInterface &input, TapeInterface &output,
+                    size_t limit);
+
+  /// @brief Тело sort() после сброса счётчиков: выбор стратегии и
+  /// синхронизация выхода.
+  void sortInto(TapeInterface &input, TapeInterface &output);
+  void externalSort(TapeInterface &input, TapeInterface &output,
+                    size_t limit);
+  void selectTopK(TapeInterface &input, TapeInterface &output, size_t k);
+
   void splitAndSort(TapeInterface &input,
-                    std::vector<std::unique_ptr<TapeInterface>> &temps);
+                    std::vector<std::unique_ptr<TapeInterface>> &temps,
+                    TapeInterface *output = nullptr, size_t limit = kNoLimit);
   void merge(TapeInterface &output,
-             std::vector<std::unique_ptr<TapeInterface>> &temps);
-  void mergeTwo(TapeInterface &in1, TapeInterface &in2, TapeInterface &out);
+             std::vector<std::unique_ptr<TapeInterface>> &temps,
+             size_t limit);
+
+  using MergeRuns = std::function<void(const std::vector<TapeInterface *> &,
+                                       TapeInterface &)>;
+
+  /// @brief Сливает temps в output по Хаффману: каждый раз сливаются
+  /// fanIn самых коротких серий, поэтому длинные серии проходят через
+  /// меньшее число слияний и суммарный объём пересылок минимален.
+  /// mergeRuns сливает группу серий в ленту.
+  bool mergeInParallel(const std::vector<TapeInterface *> &inputs,
+                       TapeInterface &output, size_t limit);
+
+  void mergeHuffman(TapeInterface &output,
+                    std::vector<std::unique_ptr<TapeInterface>> &temps,
+                    size_t fanIn, size_t limit, const MergeRuns &mergeRuns);
+  /// @brief Замена mergeHuffman для устойчивых порядков: попарно сливает
+  /// самые короткие соседние серии, сохраняя их порядок.
+  void mergeAdjacent(TapeInterface &output,
+                     std::vector<std::unique_ptr<TapeInterface>> &temps,
+                     size_t limit, const MergeRuns &mergeRuns);
+  void mergeTwo(TapeInterface &in1, TapeInterface &in2, TapeInterface &out,
+                size_t limit);
+
+  void sortReadBackward(TapeInterface &input, TapeInterface &output);
+  void mergeBackward(const std::vector<TapeInterface *> &inputs,
+                     TapeInterface &out, bool inOrder);
+
+  void sortAsync(TapeInterface &input, TapeInterface &output);
+
+  void sortForecast(TapeInterface &input, TapeInterface &output);
+
+  /// @brief Стратегия, которой sort() действительно пользуется при
+  /// порядке Order.
+  MergeStrategy effectiveStrategy() const;
+
+  /// @brief Сортирует серию в памяти в порядке Order.
+  static void sortRun(std::vector<int> &run);
 };
+
+extern template class BasicTapeSorter<Ascending>;
+extern template class BasicTapeSorter<Descending>;
+extern template class BasicTapeSorter<ByMagnitude>;
+extern template class BasicTapeSorter<StableByMagnitude>;
+
+using TapeSorter = BasicTapeSorter<Ascending>;
@@ -0,0 +1,1375 @@
+#pragma once
+
+#include "TapeSorter.h"
+
+#include "../async/AsyncTape.h"
+#include "../async/Task.h"
+#include "../async/TapeDrive.h"
+#include "../async/TapeScheduler.h"
+#include "../trace/TracingTape.h"
+#include "../utils/simdKernels.hpp"
+#include "../utils/utils.hpp"
+#include "DrivePlanner.h"
+#include "ForecastingMerger.h"
+#include "ParallelMerger.h"
+#include "SortVerification.h"
+#include "TapeView.h"
+#include "fileTapes/BinaryFileTape.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace tape_sorter_detail {
+
+// Нешаблонные помощники реализации; определены в TapeSorter.cpp.
+
+TapeConfig withoutDelays(TapeConfig config);
+
+TapeConfig withDriveDelays(TapeConfig config, const DriveConfig &drive);
+
+/// @brief Для каждого каталога — индекс первого каталога на том же
+/// устройстве. Если устройство определить не удалось, каталог считается
+/// отдельным устройством.
+std::vector<size_t> deviceClasses(const std::vector<std::string> &dirs);
+
+Task writeRunAsync(AsyncTape &tape, const std::vector<int> &run);
+
+template <typename Compare>
+Task mergeTwoAsync(AsyncTape &in1, AsyncTape &in2, AsyncTape &out,
+                   SortStats &stats) {
+  co_await in1.rewind();
+  co_await in2.rewind();
+  co_await out.rewind();
+  stats.rewinds += 3;
+
+  bool has1 = !in1.isAtEnd();
+  bool has2 = !in2.isAtEnd();
+  int val1 = 0;
+  int val2 = 0;
+
+  if (has1)
+    val1 = co_await in1.read();
+
+  if (has2)
+    val2 = co_await in2.read();
+
+  while (has1 || has2) {
+    const bool takeFirst = has1 && (!has2 || !Compare{}(val2, val1));
+
+    AsyncTape &in = takeFirst ? in1 : in2;
+    bool &has = takeFirst ? has1 : has2;
+    int &val = takeFirst ? val1 : val2;
+
+    // Выход пишется в фоне, поэтому чтение следующего элемента идёт
+    // одновременно с записью предыдущего.
+    out.writeBehind(val);
+    out.moveRightBehind();
+    ++stats.mergedElements;
+    co_await in.moveRight();
+    has = !in.isAtEnd();
+
+    if (has)
+      val = co_await in.read();
+  }
+
+  co_await out.drain();
+}
+
+} // namespace tape_sorter_detail
+
+template <typename Order>
+BasicTapeSorter<Order>::BasicTapeSorter(size_t memoryLimit, TapeConfig config,
+                                        std::string tmpDir)
+    : m_memoryLimit(memoryLimit), m_maxElements(memoryLimit / sizeof(int)),
+      m_config(config), m_tmpDir(std::move(tmpDir)) {
+  if (m_config.tempDirs.empty()) {
+    m_tempDirs.push_back(m_tmpDir);
+    return;
+  }
+
+  // Подкаталог m_tmpDir в каждом корне отделяет временные ленты
+  // нескольких TapeSorter, работающих с одними и теми же дисками.
+  for (const std::string &root : m_config.tempDirs) {
+    m_tempDirs.push_back(
+        (std::filesystem::path(root) /
+         std::filesystem::path(m_tmpDir).relative_path())
+            .string());
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::sort(TapeInterface &input, TapeInterface &output) {
+  m_stats = SortStats{};
+  m_sampled = false;
+
+  if (m_sketchBins != 0) {
+    m_stats.sketch.emplace(m_sketchBins);
+  }
+
+  if (!m_verify) {
+    sortInto(input, output);
+    return;
+  }
+
+  m_stats.verification.emplace();
+
+  VerifyingTape checked(output, &Order::less);
+  sortInto(input, checked);
+
+  SortVerification &verification = *m_stats.verification;
+  checked.report(verification);
+
+  if (!verification.sorted) {
+    throw std::runtime_error(
+        "Sort verification failed: output is not sorted at position " +
+        std::to_string(verification.firstUnsorted));
+  }
+
+  if (verification.input != verification.output) {
+    throw std::runtime_error(
+        "Sort verification failed: output checksum differs from input");
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::sortInto(TapeInterface &input,
+                                      TapeInterface &output) {
+  if (countingSort(input, output, kNoLimit)) {
+    output.sync();
+    return;
+  }
+
+  const MergeStrategy strategy = effectiveStrategy();
+
+  if (strategy == MergeStrategy::ReadBackward) {
+    runInTmpDir([&] { sortReadBackward(input, output); });
+  } else if (strategy == MergeStrategy::Async) {
+    runInTmpDir([&] { sortAsync(input, output); });
+  } else if (strategy == MergeStrategy::Forecast) {
+    runInTmpDir([&] { sortForecast(input, output); });
+  } else {
+    externalSort(input, output, kNoLimit);
+  }
+
+  // Выход синхронизируется один раз, когда он готов целиком.
+  output.sync();
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::sortTopK(TapeInterface &input,
+                                      TapeInterface &output, size_t k) {
+  m_stats = SortStats{};
+  m_sampled = false;
+
+  if (m_sketchBins != 0) {
+    m_stats.sketch.emplace(m_sketchBins);
+  }
+
+  if (k == 0) {
+    return;
+  }
+
+  // Куча не сохраняет порядок равных элементов.
+  if (!Order::kStable && k <= m_maxElements) {
+    selectTopK(input, output, k);
+  } else if (!countingSort(input, output, k)) {
+    externalSort(input, output, k);
+  }
+
+  output.sync();
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::mergeSorted(
+    const std::vector<TapeInterface *> &inputs, TapeInterface &output,
+    bool assumeSorted) {
+  m_stats = SortStats{};
+  m_sampled = false;
+
+  std::vector<std::unique_ptr<TapeInterface>> temps;
+
+  runInTmpDir([&] {
+    for (TapeInterface *input : inputs) {
+      if (assumeSorted || isSorted(*input)) {
+        temps.push_back(std::make_unique<TapeView>(*input));
+      } else {
+        splitAndSort(*input, temps);
+      }
+    }
+
+    merge(output, temps, kNoLimit);
+  });
+
+  output.sync();
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::setMergeStrategy(MergeStrategy strategy) {
+  m_strategy = strategy;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::setMemoryLimit(size_t memoryLimit) {
+  m_memoryLimit = memoryLimit;
+  m_maxElements = memoryLimit / sizeof(int);
+
+  // Буфер серий переживает сортировки, но не должен превышать новый лимит.
+  if (m_buffer.capacity() > m_maxElements) {
+    std::vector<int>().swap(m_buffer);
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::setMergeThreads(size_t threads) {
+  m_mergeThreads = std::max<size_t>(1, threads);
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::setVerify(bool verify) {
+  m_verify = verify;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::setSketch(size_t histogramBins) {
+  m_sketchBins = histogramBins;
+}
+
+template <typename Order>
+DataSketch BasicTapeSorter<Order>::sketch(TapeInterface &input,
+                                          size_t histogramBins) {
+  m_stats = SortStats{};
+  m_stats.sketch.emplace(histogramBins);
+
+  rewindTape(input);
+
+  while (!input.isAtEnd()) {
+    readInput(input);
+    input.moveRight();
+  }
+
+  return *m_stats.sketch;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::setTraceRecorder(TraceRecorder *recorder) {
+  m_traceRecorder = recorder;
+}
+
+template <typename Order>
+const SortStats &BasicTapeSorter<Order>::getStats() const { return m_stats; }
+
+template <typename Order>
+void BasicTapeSorter<Order>::externalSort(TapeInterface &input,
+                                          TapeInterface &output, size_t limit) {
+  std::vector<std::unique_ptr<TapeInterface>> temps;
+
+  runInTmpDir([&] {
+    splitAndSort(input, temps, &output, limit);
+    merge(output, temps, limit);
+  });
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::runInTmpDir(const std::function<void()> &job) {
+  // Каталог создаётся лениво и может вовсе не появиться, поэтому ошибки
+  // его удаления не должны ломать успешную сортировку.
+  std::error_code ignored;
+
+  const auto cleanup = [&] {
+    for (const std::string &dir : m_tempDirs) {
+      std::filesystem::remove_all(dir, ignored);
+    }
+
+    m_tempDirOf.clear();
+  };
+
+  m_tempDevices = tape_sorter_detail::deviceClasses(m_tempDirs);
+
+  try {
+
+    job();
+
+    cleanup();
+
+  } catch (const std::exception &e) {
+    cleanup();
+    throw std::runtime_error("[SORT]" + std::string(e.what()));
+  }
+}
+
+template <typename Order>
+std::unique_ptr<TapeInterface>
+BasicTapeSorter<Order>::createTempTape(
+    const std::string &name, size_t maxBytes,
+    const std::vector<const TapeInterface *> &inputs) {
+  if (m_config.drives.empty()) {
+    return createTempTape(name, maxBytes, m_config, inputs);
+  }
+
+  // Без планировщика приводы назначаются по кругу.
+  const DriveConfig &drive =
+      m_config.drives[m_nextDrive++ % m_config.drives.size()];
+  return createTempTape(name, maxBytes,
+                        tape_sorter_detail::withDriveDelays(m_config, drive),
+                        inputs);
+}
+
+template <typename Order>
+std::unique_ptr<TapeInterface>
+BasicTapeSorter<Order>::createTempTape(
+    const std::string &name, size_t maxBytes, const TapeConfig &config,
+    const std::vector<const TapeInterface *> &inputs) {
+  const size_t index = pickTempDir(inputs);
+  const std::string &dir = m_tempDirs[index];
+
+  if (!std::filesystem::create_directories(dir) &&
+      !std::filesystem::exists(dir)) {
+    throw std::runtime_error("Failed to create directory: " + dir);
+  }
+
+  std::unique_ptr<TapeInterface> tape =
+      utils::createFileTape(maxBytes, config, dir + "/" + name + ".bin",
+                            config.tempDirectIo, config.tempDurability);
+
+  if (m_traceRecorder != nullptr) {
+    tape = std::make_unique<TracingTape>(std::move(tape), *m_traceRecorder);
+  }
+
+  m_tempDirOf[tape.get()] = index;
+  return tape;
+}
+
+template <typename Order>
+size_t
+BasicTapeSorter<Order>::pickTempDir(
+    const std::vector<const TapeInterface *> &inputs) {
+  const size_t count = m_tempDirs.size();
+
+  if (count == 1) {
+    return 0;
+  }
+
+  // Выход слияния не должен делить устройство с его входами: тогда
+  // чтение и запись идут на разные диски параллельно.
+  std::vector<bool> busy(count, false);
+
+  for (const TapeInterface *input : inputs) {
+    const auto it = m_tempDirOf.find(input);
+
+    if (it != m_tempDirOf.end()) {
+      busy[m_tempDevices[it->second]] = true;
+    }
+  }
+
+  std::vector<size_t> candidates;
+  for (size_t i = 0; i < count; ++i) {
+    if (!busy[m_tempDevices[i]]) {
+      candidates.push_back(i);
+    }
+  }
+
+  if (candidates.empty()) {
+    for (size_t i = 0; i < count; ++i) {
+      candidates.push_back(i);
+    }
+  }
+
+  size_t best = candidates.front();
+
+  if (m_config.tempPlacement == TempPlacement::FreeSpace) {
+    std::uintmax_t bestFree = 0;
+
+    for (size_t i : candidates) {
+      std::error_code error;
+      const std::filesystem::space_info space =
+          std::filesystem::space(m_config.tempDirs[i], error);
+
+      if (!error && space.available > bestFree) {
+        best = i;
+        bestFree = space.available;
+      }
+    }
+
+    return best;
+  }
+
+  // Ближайший допустимый каталог по кругу.
+  const size_t start = m_nextTempDir % count;
+  for (size_t i : candidates) {
+    if ((i + count - start) % count < (best + count - start) % count) {
+      best = i;
+    }
+  }
+
+  m_nextTempDir = best + 1;
+  return best;
+}
+
+template <typename Order>
+bool BasicTapeSorter<Order>::mergeInParallel(
+    const std::vector<TapeInterface *> &inputs, TapeInterface &output,
+    size_t limit) {
+  // ParallelMerger сливает только по возрастанию.
+  if (!std::is_same_v<Order, Ascending> || m_mergeThreads <= 1) {
+    return false;
+  }
+
+  // Позиционный доступ есть только у файлов BinaryFileTape; ленты в
+  // декораторах (трассировка, TapeView) и O_DIRECT сливаются по-старому.
+  auto *outputFile = dynamic_cast<BinaryFileTape *>(&output);
+  std::vector<BinaryFileTape *> inputFiles;
+  std::vector<std::string> files;
+  size_t total = 0;
+
+  for (TapeInterface *input : inputs) {
+    auto *file = dynamic_cast<BinaryFileTape *>(input);
+
+    if (file == nullptr || outputFile == nullptr) {
+      return false;
+    }
+
+    inputFiles.push_back(file);
+    files.push_back(file->getFilename());
+    total += file->getSize();
+  }
+
+  // ParallelMerger читает и пишет файлы в обход лент, а записи лент
+  // могут ещё лежать в их буферах.
+  for (BinaryFileTape *file : inputFiles) {
+    file->flush();
+  }
+
+  outputFile->flush();
+
+  if (std::min(total, limit) > outputFile->getMaxSize()) {
+    throw std::out_of_range("Write position exceeds maximum size");
+  }
+
+  // Память делится между потоками: у каждого буферы всех входов и выхода.
+  const size_t bufferElements = std::max<size_t>(
+      1, m_maxElements / (m_mergeThreads * (inputs.size() + 1)));
+
+  const size_t written =
+      ParallelMerger(std::move(files), m_mergeThreads, bufferElements)
+          .merge(outputFile->getFilename(), limit);
+
+  outputFile->reload();
+  m_stats.mergedElements += written;
+  return true;
+}
+
+template <typename Order>
+size_t BasicTapeSorter<Order>::runLength(size_t inputSize, size_t run) const {
+  if (inputSize <= m_maxElements || m_maxElements == 0) {
+    return m_maxElements;
+  }
+
+  // Длины серий отличаются не больше чем на единицу, а число серий то же,
+  // что и при полных сериях.
+  const size_t runs = (inputSize + m_maxElements - 1) / m_maxElements;
+  return inputSize / runs + (run < inputSize % runs ? 1 : 0);
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::writeRun(const std::vector<int> &run,
+                                      TapeInterface &output, size_t limit) {
+  rewindTape(output);
+
+  const size_t size = std::min(run.size(), limit);
+
+  for (size_t i = 0; i < size; ++i) {
+    output.write(run[i]);
+    output.moveRight();
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::rewindTape(TapeInterface &tape) {
+  tape.rewind();
+  ++m_stats.rewinds;
+}
+
+template <typename Order>
+int BasicTapeSorter<Order>::readInput(TapeInterface &input) {
+  const int value = input.read();
+  addInput(value);
+  return value;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::addInput(int value) {
+  if (m_stats.sketch) {
+    m_stats.sketch->add(value);
+  }
+
+  if (m_stats.verification) {
+    m_stats.verification->input.add(value);
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::beginInput(TapeInterface &input) {
+  if (!m_sampled) {
+    rewindTape(input);
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::beginRun() {
+  if (m_sampled) {
+    m_sampled = false;
+    return;
+  }
+
+  m_buffer.clear();
+}
+
+template <typename Order>
+bool BasicTapeSorter<Order>::countingSort(TapeInterface &input,
+                                          TapeInterface &output, size_t limit) {
+  // Вход, помещающийся в память, и так сортируется за один проход. Размер
+  // потоковых лент неизвестен заранее, а перечитать их после отказа нельзя.
+  if (!isTotalOrder<Comparator> || input.getSize() <= m_maxElements) {
+    return false;
+  }
+
+  const size_t maxDistinct = m_memoryLimit / kCountEntryBytes;
+  if (maxDistinct == 0) {
+    return false;
+  }
+
+  // Сначала решает короткая выборка из начала входа. Она читается в
+  // буфер серий и не длиннее первой серии, поэтому при отказе становится
+  // её началом, и вход не перечитывается.
+  const size_t sampleSize =
+      std::min(kCountSample, runLength(input.getSize(), 0));
+  std::vector<int> &sample = m_buffer;
+  sample.clear();
+  rewindTape(input);
+
+  while (sample.size() < sampleSize && !input.isAtEnd()) {
+    sample.push_back(input.read());
+    input.moveRight();
+  }
+
+  std::sort(sample.begin(), sample.end(), Comparator{});
+
+  size_t distinct = 0;
+  for (size_t i = 0; i < sample.size(); ++i) {
+    if (i == 0 || Comparator{}(sample[i - 1], sample[i])) {
+      ++distinct;
+    }
+  }
+
+  // Если различных значений больше половины выборки, значения в среднем
+  // почти не повторяются, и счётчики не окупят себя на всём входе.
+  if (distinct > maxDistinct || 2 * distinct > sample.size()) {
+    for (int value : sample) {
+      addInput(value);
+    }
+
+    m_sampled = true;
+    return false;
+  }
+
+  std::map<int, size_t, Comparator> counts;
+  Checksum checksum;
+
+  // Сумма считается по прочитанным значениям, а не по счётчикам, чтобы
+  // проверка не зависела от них.
+  for (int value : sample) {
+    ++counts[value];
+
+    if (m_stats.verification) {
+      checksum.add(value);
+    }
+  }
+
+  // Выборка перешла в счётчики: буфер серий отдаёт память, и счётчики
+  // вместе с ним не выходят за m_memoryLimit.
+  std::vector<int>().swap(m_buffer);
+
+  while (!input.isAtEnd()) {
+    const int value = input.read();
+    input.moveRight();
+
+    ++counts[value];
+
+    if (m_stats.verification) {
+      checksum.add(value);
+    }
+
+    // Дальше вход оказался разнообразнее выборки. Счётчики освобождаются
+    // до того, как серии займут буфер, и вход читается заново.
+    if (counts.size() > maxDistinct) {
+      return false;
+    }
+  }
+
+  if (m_stats.verification) {
+    m_stats.verification->input = checksum;
+  }
+
+  // Проход подсчёта мог оборваться, поэтому эскиз строится по готовым
+  // счётчикам, а не по ходу чтения.
+  if (m_stats.sketch) {
+    for (const auto &[value, count] : counts) {
+      for (size_t i = 0; i < count; ++i) {
+        m_stats.sketch->quantiles.add(value);
+      }
+
+      m_stats.sketch->histogram.add(value, count);
+    }
+  }
+
+  rewindTape(output);
+
+  size_t written = 0;
+  for (const auto &[value, count] : counts) {
+    for (size_t i = 0; i < count && written < limit; ++i, ++written) {
+      output.write(value);
+      output.moveRight();
+    }
+  }
+
+  m_stats.countingSort = true;
+  return true;
+}
+
+template <typename Order>
+bool BasicTapeSorter<Order>::isSorted(TapeInterface &tape) {
+  rewindTape(tape);
+
+  if (tape.isAtEnd()) {
+    return true;
+  }
+
+  int prev = tape.read();
+  tape.moveRight();
+
+  while (!tape.isAtEnd()) {
+    int current = tape.read();
+
+    if (Comparator{}(current, prev)) {
+      return false;
+    }
+
+    prev = current;
+    tape.moveRight();
+  }
+
+  return true;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::selectTopK(TapeInterface &input,
+                                        TapeInterface &output, size_t k) {
+  // Наверху кучи — последний в порядке Order из k отобранных.
+  std::priority_queue<int, std::vector<int>, Comparator> heap;
+  rewindTape(input);
+
+  while (!input.isAtEnd()) {
+    int x = readInput(input);
+
+    if (heap.size() < k) {
+      heap.push(x);
+    } else if (Comparator{}(x, heap.top())) {
+      heap.pop();
+      heap.push(x);
+    }
+
+    input.moveRight();
+  }
+
+  std::vector<int> smallest(heap.size());
+  for (auto it = smallest.rbegin(); it != smallest.rend(); ++it) {
+    *it = heap.top();
+    heap.pop();
+  }
+
+  writeRun(smallest, output, kNoLimit);
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::splitAndSort(
+    TapeInterface &input, std::vector<std::unique_ptr<TapeInterface>> &temps,
+    TapeInterface *output, size_t limit) {
+  std::vector<int> &buffer = m_buffer;
+  beginInput(input);
+
+  // Серии здесь не выравниваются: mergeHuffman сам опускает короткую
+  // последнюю серию вниз дерева, и неравные серии дают ему меньший объём
+  // пересылок, чем равные.
+  while (!input.isAtEnd()) {
+    beginRun();
+
+    while (buffer.size() < m_maxElements && !input.isAtEnd()) {
+      buffer.push_back(readInput(input));
+      input.moveRight();
+    }
+
+    sortRun(buffer);
+
+    // Весь вход уместился в одну серию: временная лента не нужна.
+    if (output != nullptr && temps.empty() && input.isAtEnd()) {
+      writeRun(buffer, *output, limit);
+      ++m_stats.runs;
+      return;
+    }
+
+    auto temp = createTempTape("temp_" + std::to_string(temps.size()),
+                               m_memoryLimit);
+
+    for (int num : buffer) {
+      temp->write(num);
+      temp->moveRight();
+    }
+
+    temp->sync();
+    rewindTape(*temp);
+    temps.push_back(std::move(temp));
+    ++m_stats.runs;
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::merge(
+    TapeInterface &output, std::vector<std::unique_ptr<TapeInterface>> &temps,
+    size_t limit) {
+  if (temps.size() >= 2) {
+    const MergeRuns mergeRuns = [&](const std::vector<TapeInterface *> &inputs,
+                                    TapeInterface &out) {
+      mergeTwo(*inputs[0], *inputs[1], out, limit);
+    };
+
+    if constexpr (Order::kStable) {
+      mergeAdjacent(output, temps, limit, mergeRuns);
+    } else {
+      mergeHuffman(output, temps, 2, limit, mergeRuns);
+    }
+
+    return;
+  }
+
+  // Единственная серия остаётся только у mergeSorted с одним входом.
+  if (!temps.empty()) {
+    rewindTape(*temps.front());
+    rewindTape(output);
+
+    size_t size = std::min(temps.front()->getSize(), limit);
+    utils::copyTape(*temps.front(), output, size);
+
+    m_stats.mergedElements += size;
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::mergeHuffman(
+    TapeInterface &output, std::vector<std::unique_ptr<TapeInterface>> &temps,
+    size_t fanIn, size_t limit, const MergeRuns &mergeRuns) {
+  struct Node {
+    size_t size;
+    size_t depth;
+    size_t index;
+  };
+
+  // При равной длине первой сливается более старая серия.
+  const auto longer = [](const Node &a, const Node &b) {
+    return a.size != b.size ? a.size > b.size : a.index > b.index;
+  };
+
+  std::priority_queue<Node, std::vector<Node>, decltype(longer)> queue(
+      longer);
+
+  for (size_t i = 0; i < temps.size(); ++i) {
+    queue.push({std::min(temps[i]->getSize(), limit), 0, i});
+  }
+
+  const auto takeGroup = [&](size_t count, std::vector<size_t> &indices,
+                             std::vector<TapeInterface *> &group) {
+    Node merged{0, 0, temps.size()};
+
+    for (size_t i = 0; i < count; ++i) {
+      const Node node = queue.top();
+      queue.pop();
+
+      indices.push_back(node.index);
+      group.push_back(temps[node.index].get());
+      merged.size += node.size;
+      merged.depth = std::max(merged.depth, node.depth + 1);
+    }
+
+    merged.size = std::min(merged.size, limit);
+    return merged;
+  };
+
+  // Первое слияние берёт столько серий, чтобы дальше все слияния были
+  // полными fanIn-путевыми: это те же фиктивные серии нулевой длины, что
+  // добавляет k-ичный алгоритм Хаффмана.
+  size_t count = (temps.size() - 2) % (fanIn - 1) + 2;
+
+  while (queue.size() > fanIn) {
+    std::vector<size_t> indices;
+    std::vector<TapeInterface *> group;
+    const Node node = takeGroup(count, indices, group);
+
+    auto merged = createTempTape(
+        "merge_" + std::to_string(temps.size()), node.size * sizeof(int),
+        std::vector<const TapeInterface *>(group.begin(), group.end()));
+
+    mergeRuns(group, *merged);
+    merged->sync();
+
+    for (size_t index : indices) {
+      temps[index].reset();
+    }
+
+    temps.push_back(std::move(merged));
+    queue.push(node);
+    count = fanIn;
+  }
+
+  // Последнее слияние пишет сразу в output.
+  std::vector<size_t> indices;
+  std::vector<TapeInterface *> group;
+  const Node node = takeGroup(queue.size(), indices, group);
+
+  if (!mergeInParallel(group, output, limit)) {
+    mergeRuns(group, output);
+  }
+
+  m_stats.mergePasses = node.depth;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::mergeAdjacent(
+    TapeInterface &output, std::vector<std::unique_ptr<TapeInterface>> &temps,
+    size_t limit, const MergeRuns &mergeRuns) {
+  struct Node {
+    size_t size;
+    size_t depth;
+    size_t index;
+  };
+
+  // Серии в порядке входа. Сливаются только соседние, и более ранняя идёт
+  // первой, поэтому равные элементы сохраняют порядок входа.
+  std::vector<Node> sequence;
+
+  for (size_t i = 0; i < temps.size(); ++i) {
+    sequence.push_back({std::min(temps[i]->getSize(), limit), 0, i});
+  }
+
+  while (sequence.size() > 2) {
+    // Самая короткая пара соседей: как и у Хаффмана, длинные серии
+    // проходят через меньшее число слияний.
+    size_t best = 0;
+
+    for (size_t i = 1; i + 1 < sequence.size(); ++i) {
+      if (sequence[i].size + sequence[i + 1].size <
+          sequence[best].size + sequence[best + 1].size) {
+        best = i;
+      }
+    }
+
+    Node &first = sequence[best];
+    const Node second = sequence[best + 1];
+    const std::vector<TapeInterface *> group{temps[first.index].get(),
+                                             temps[second.index].get()};
+    const size_t size = std::min(first.size + second.size, limit);
+
+    auto merged = createTempTape(
+        "merge_" + std::to_string(temps.size()), size * sizeof(int),
+        std::vector<const TapeInterface *>(group.begin(), group.end()));
+
+    mergeRuns(group, *merged);
+    merged->sync();
+
+    temps[first.index].reset();
+    temps[second.index].reset();
+
+    first = {size, std::max(first.depth, second.depth) + 1, temps.size()};
+    temps.push_back(std::move(merged));
+    sequence.erase(sequence.begin() + static_cast<std::ptrdiff_t>(best) + 1);
+  }
+
+  mergeRuns({temps[sequence[0].index].get(), temps[sequence[1].index].get()},
+            output);
+
+  m_stats.mergePasses = std::max(sequence[0].depth, sequence[1].depth) + 1;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::mergeTwo(TapeInterface &in1, TapeInterface &in2,
+                                      TapeInterface &out, size_t limit) {
+  rewindTape(in1);
+  rewindTape(in2);
+  rewindTape(out);
+
+  bool has1 = !in1.isAtEnd();
+  bool has2 = !in2.isAtEnd();
+  int val1 = has1 ? in1.read() : 0;
+  int val2 = has2 ? in2.read() : 0;
+
+  size_t written = 0;
+
+  while (has1 && has2 && written < limit) {
+
+    // При равенстве берётся in1: слияние устойчиво, если in1 — более
+    // ранняя серия.
+    if (!Comparator{}(val2, val1)) {
+      out.write(val1);
+      out.moveRight();
+      in1.moveRight();
+      has1 = !in1.isAtEnd();
+
+      if (has1)
+        val1 = in1.read();
+
+    } else {
+      out.write(val2);
+      out.moveRight();
+      in2.moveRight();
+      has2 = !in2.isAtEnd();
+
+      if (has2)
+        val2 = in2.read();
+    }
+
+    ++written;
+  }
+
+  while (has1 && written < limit) {
+    out.write(val1);
+    out.moveRight();
+    in1.moveRight();
+
+    has1 = !in1.isAtEnd();
+
+    if (has1)
+      val1 = in1.read();
+
+    ++written;
+  }
+
+  while (has2 && written < limit) {
+    out.write(val2);
+    out.moveRight();
+    in2.moveRight();
+
+    has2 = !in2.isAtEnd();
+
+    if (has2)
+      val2 = in2.read();
+
+    ++written;
+  }
+
+  m_stats.mergedElements += written;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::sortReadBackward(TapeInterface &input,
+                                              TapeInterface &output) {
+  const size_t size = input.getSize();
+
+  if (size == 0 || m_maxElements == 0) {
+    return;
+  }
+
+  const size_t runCount = (size + m_maxElements - 1) / m_maxElements;
+
+  std::vector<int> &buffer = m_buffer;
+  beginInput(input);
+
+  if (runCount == 1) {
+    beginRun();
+
+    while (!input.isAtEnd()) {
+      buffer.push_back(readInput(input));
+      input.moveRight();
+    }
+
+    sortRun(buffer);
+    writeRun(buffer, output, kNoLimit);
+    ++m_stats.runs;
+    return;
+  }
+
+  // Каждый уровень слияния меняет направление серий, а последний уровень
+  // должен дать в output порядок Order, поэтому направление начальных
+  // серий определяется чётностью числа уровней.
+  size_t levels = 0;
+  for (size_t runs = runCount; runs > 1; runs /= 2) {
+    ++levels;
+  }
+
+  bool inOrder = levels % 2 == 0;
+
+  std::vector<std::unique_ptr<TapeInterface>> temps;
+
+  while (!input.isAtEnd()) {
+    beginRun();
+
+    const size_t length = runLength(size, temps.size());
+    while (buffer.size() < length && !input.isAtEnd()) {
+      buffer.push_back(readInput(input));
+      input.moveRight();
+    }
+
+    sortRun(buffer);
+
+    if (!inOrder) {
+      std::reverse(buffer.begin(), buffer.end());
+    }
+
+    auto temp = createTempTape("temp_" + std::to_string(temps.size()),
+                               m_memoryLimit);
+
+    // Головка остаётся за последним элементом: отсюда следующий проход
+    // начнёт чтение в обратном направлении.
+    for (int num : buffer) {
+      temp->write(num);
+      temp->moveRight();
+    }
+
+    temp->sync();
+    temps.push_back(std::move(temp));
+    ++m_stats.runs;
+  }
+
+  for (size_t level = 1; level <= levels; ++level) {
+    inOrder = !inOrder;
+    const bool last = level == levels;
+
+    std::vector<std::unique_ptr<TapeInterface>> newTemps;
+
+    // При нечётном числе серий последняя группа сливает три серии, чтобы
+    // ни одна серия не переносилась на следующий уровень в старом
+    // направлении.
+    const size_t groups = temps.size() / 2;
+
+    if (last) {
+      rewindTape(output);
+    }
+
+    for (size_t group = 0; group < groups; ++group) {
+      const size_t begin = group * 2;
+      const size_t end = group + 1 == groups ? temps.size() : begin + 2;
+
+      std::vector<TapeInterface *> inputs;
+      size_t mergedSize = 0;
+
+      for (size_t i = begin; i < end; ++i) {
+        inputs.push_back(temps[i].get());
+        mergedSize += temps[i]->getSize();
+      }
+
+      if (last) {
+        mergeBackward(inputs, output, inOrder);
+        continue;
+      }
+
+      auto merged = createTempTape(
+          "merge_" + std::to_string(level) + "_" + std::to_string(group),
+          mergedSize * sizeof(int),
+          std::vector<const TapeInterface *>(inputs.begin(), inputs.end()));
+
+      mergeBackward(inputs, *merged, inOrder);
+      merged->sync();
+      newTemps.push_back(std::move(merged));
+    }
+
+    temps = std::move(newTemps);
+    ++m_stats.mergePasses;
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::mergeBackward(
+    const std::vector<TapeInterface *> &inputs, TapeInterface &out,
+    bool inOrder) {
+  struct Cursor {
+    TapeInterface *tape;
+    size_t remaining;
+    int value;
+  };
+
+  std::vector<Cursor> cursors;
+
+  for (TapeInterface *tape : inputs) {
+    Cursor cursor{tape, tape->getSize(), 0};
+
+    if (cursor.remaining > 0) {
+      tape->moveLeft();
+      cursor.value = tape->read();
+    }
+
+    cursors.push_back(cursor);
+  }
+
+  while (true) {
+    Cursor *best = nullptr;
+
+    for (auto &cursor : cursors) {
+      if (cursor.remaining == 0) {
+        continue;
+      }
+
+      if (best == nullptr ||
+          (inOrder ? Comparator{}(cursor.value, best->value)
+                   : Comparator{}(best->value, cursor.value))) {
+        best = &cursor;
+      }
+    }
+
+    if (best == nullptr) {
+      break;
+    }
+
+    out.write(best->value);
+    out.moveRight();
+    ++m_stats.mergedElements;
+
+    if (--best->remaining > 0) {
+      best->tape->moveLeft();
+      best->value = best->tape->read();
+    }
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::sortAsync(TapeInterface &input,
+                                       TapeInterface &output) {
+  struct AsyncRun {
+    std::unique_ptr<TapeInterface> tape;
+    std::unique_ptr<AsyncTape> async;
+    size_t drive = 0;
+  };
+
+  TapeScheduler scheduler;
+
+  // Временные ленты работают без задержек: их моделирует планировщик.
+  const TapeConfig storageConfig =
+      tape_sorter_detail::withoutDelays(m_config);
+
+  // Если приводы заданы, все временные ленты привязаны к ним, а слияния
+  // раскладываются по шагам DrivePlanner. Иначе каждая лента — отдельный
+  // привод, и все слияния уровня идут одним шагом.
+  std::optional<DrivePlanner> planner;
+  std::vector<std::unique_ptr<TapeDrive>> drives;
+
+  if (!m_config.drives.empty()) {
+    planner.emplace(m_config.drives);
+
+    for (const DriveConfig &drive : m_config.drives) {
+      drives.push_back(std::make_unique<TapeDrive>(
+          scheduler, tape_sorter_detail::withDriveDelays(m_config, drive)));
+    }
+  }
+
+  const auto createRun = [&](const std::string &name, size_t maxBytes,
+                             size_t drive,
+                             const std::vector<const TapeInterface *> &inputs) {
+    AsyncRun run;
+    run.tape = createTempTape(name, maxBytes, storageConfig, inputs);
+    run.drive = drive;
+    run.async = drives.empty()
+                    ? std::make_unique<AsyncTape>(scheduler, *run.tape,
+                                                  m_config)
+                    : std::make_unique<AsyncTape>(*drives[drive], *run.tape);
+    return run;
+  };
+
+  std::vector<AsyncRun> runs;
+  std::vector<int> &buffer = m_buffer;
+  beginInput(input);
+
+  const size_t size = input.getSize();
+
+  while (!input.isAtEnd()) {
+    beginRun();
+
+    const size_t length = runLength(size, runs.size());
+    while (buffer.size() < length && !input.isAtEnd()) {
+      buffer.push_back(readInput(input));
+      input.moveRight();
+    }
+
+    sortRun(buffer);
+    ++m_stats.runs;
+
+    if (runs.empty() && input.isAtEnd()) {
+      writeRun(buffer, output, kNoLimit);
+      return;
+    }
+
+    const size_t drive = planner ? planner->placeRun(buffer.size()) : 0;
+    AsyncRun run = createRun("temp_" + std::to_string(runs.size()),
+                             m_memoryLimit, drive, {});
+
+    scheduler.spawn(tape_sorter_detail::writeRunAsync(*run.async, buffer));
+    scheduler.run();
+    run.tape->sync();
+
+    runs.push_back(std::move(run));
+  }
+
+  // Выход — отдельный привод планировщика с задержками самой выходной
+  // ленты, а данные идут через второй её экземпляр без задержек: иначе
+  // паузы выхода останавливали бы единственный поток планировщика вместе
+  // с чтением серий. Ленту в декораторе (трассировка, индекс, проверка)
+  // так не открыть, и её задержки остаются в ней самой.
+  auto *outputFile = dynamic_cast<BinaryFileTape *>(&output);
+  std::unique_ptr<BinaryFileTape> outputView;
+  std::unique_ptr<AsyncTape> asyncOutput;
+
+  if (outputFile != nullptr) {
+    outputFile->flush();
+    outputView = std::make_unique<BinaryFileTape>(
+        outputFile->getFilename(), outputFile->getMaxSize() * sizeof(int),
+        tape_sorter_detail::withoutDelays(outputFile->getConfig()));
+    asyncOutput = std::make_unique<AsyncTape>(scheduler, *outputView,
+                                              outputFile->getConfig());
+  } else {
+    asyncOutput = std::make_unique<AsyncTape>(
+        scheduler, output, tape_sorter_detail::withoutDelays(m_config));
+  }
+
+  while (runs.size() > 1) {
+    const bool last = runs.size() == 2;
+
+    std::vector<std::vector<PlannedMerge>> steps;
+
+    // Последнее слияние пишет в выход, а не на привод планировщика.
+    if (planner && !last) {
+      std::vector<PlacedRun> placed;
+      for (const AsyncRun &run : runs) {
+        placed.push_back({run.drive, run.tape->getSize()});
+      }
+      steps = planner->planLevel(placed);
+    } else {
+      steps.emplace_back();
+      for (size_t i = 0; i + 1 < runs.size(); i += 2) {
+        steps.back().push_back({i, i + 1, 0});
+      }
+    }
+
+    std::vector<AsyncRun> newRuns;
+    std::vector<bool> merged(runs.size(), false);
+
+    for (const auto &step : steps) {
+      for (const PlannedMerge &plan : step) {
+        AsyncRun &first = runs[plan.first];
+        AsyncRun &second = runs[plan.second];
+        merged[plan.first] = true;
+        merged[plan.second] = true;
+
+        if (last) {
+          scheduler.spawn(tape_sorter_detail::mergeTwoAsync<Comparator>(
+              *first.async, *second.async, *asyncOutput, m_stats));
+          continue;
+        }
+
+        const size_t mergedSize = first.tape->getSize() +
+                                  second.tape->getSize();
+
+        AsyncRun result = createRun("merge_" + std::to_string(runs.size()) +
+                                        "_" + std::to_string(newRuns.size()),
+                                    mergedSize * sizeof(int),
+                                    plan.outputDrive,
+                                    {first.tape.get(), second.tape.get()});
+
+        scheduler.spawn(tape_sorter_detail::mergeTwoAsync<Comparator>(
+            *first.async, *second.async, *result.async, m_stats));
+        newRuns.push_back(std::move(result));
+      }
+
+      // Слияния шага идут одновременно.
+      scheduler.run();
+    }
+
+    for (AsyncRun &run : newRuns) {
+      run.tape->sync();
+    }
+
+    for (size_t i = 0; i < runs.size(); ++i) {
+      if (!merged[i]) {
+        newRuns.push_back(std::move(runs[i]));
+      }
+    }
+
+    runs = std::move(newRuns);
+    ++m_stats.mergePasses;
+  }
+
+  if (outputView != nullptr) {
+    outputView->flush();
+    outputFile->reload();
+  }
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::sortForecast(TapeInterface &input,
+                                          TapeInterface &output) {
+  std::vector<std::unique_ptr<TapeInterface>> temps;
+  splitAndSort(input, temps, &output);
+
+  if (temps.empty()) {
+    return;
+  }
+
+  // Степень слияния — сколько блоков не меньше kMinForecastBlock умещается
+  // в памяти вместе с запасным.
+  const size_t blocks = m_maxElements / kMinForecastBlock;
+  const size_t fanIn = blocks > 3 ? blocks - 1 : 2;
+  const size_t blockElements =
+      std::max<size_t>(1, m_maxElements / (fanIn + 1));
+
+  mergeHuffman(output, temps, fanIn, kNoLimit,
+               [&](const std::vector<TapeInterface *> &inputs,
+                   TapeInterface &out) {
+                 for (TapeInterface *tape : inputs) {
+                   rewindTape(*tape);
+                 }
+
+                 rewindTape(out);
+                 m_stats.mergedElements +=
+                     ForecastingMerger(inputs, blockElements).merge(out);
+               });
+}
+
+template <typename Order>
+MergeStrategy BasicTapeSorter<Order>::effectiveStrategy() const {
+  // Обратное чтение и уровни сопрограмм сливают серии не в порядке входа,
+  // а ForecastingMerger сравнивает только по возрастанию.
+  if (Order::kStable || (m_strategy == MergeStrategy::Forecast &&
+                         !std::is_same_v<Order, Ascending>)) {
+    return MergeStrategy::Pairwise;
+  }
+
+  return m_strategy;
+}
+
+template <typename Order>
+void BasicTapeSorter<Order>::sortRun(std::vector<int> &run) {
+  if constexpr (std::is_same_v<Order, Ascending>) {
+    utils::simd::sort(run.data(), run.size());
+  } else if constexpr (std::is_same_v<Order, Descending>) {
+    // Равные int неотличимы, поэтому развёрнутая возрастающая серия и есть
+    // убывающая.
+    utils::simd::sort(run.data(), run.size());
+    std::reverse(run.begin(), run.end());
+  } else if constexpr (Order::kStable) {
+    std::stable_sort(run.begin(), run.end(), Comparator{});
+  } else {
+    std::sort(run.begin(), run.end(), Comparator{});
+  }
+}
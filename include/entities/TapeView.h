@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../interfaces/TapeInterface.h"
+
+/// @brief Невладеющая обёртка над лентой: позволяет передать внешнюю ленту
+/// туда, где ожидается std::unique_ptr<TapeInterface>, не забирая владение.
+class TapeView : public TapeInterface {
+public:
+  explicit TapeView(TapeInterface &tape) : m_tape(tape) {}
+
+  int read() final { return m_tape.read(); }
+
+  void write(int data) final { m_tape.write(data); }
+
+  void moveLeft() final { m_tape.moveLeft(); }
+
+  void moveRight() final { m_tape.moveRight(); }
+
+  void rewind() final { m_tape.rewind(); }
+
+  bool isAtEnd() const final { return m_tape.isAtEnd(); }
+
+  size_t getSize() const final { return m_tape.getSize(); }
+
+  void sync() final { m_tape.sync(); }
+
+  TapeInterface &getTape() const { return m_tape; }
+
+private:
+  TapeInterface &m_tape;
+};
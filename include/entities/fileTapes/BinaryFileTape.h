@@ -8,8 +8,12 @@
 
 class BinaryFileTape : public TapeInterface {
 public:
+  /// @brief Записи не сбрасываются в файл поодиночке: они копятся в буфере
+  /// потока до точки синхронизации, где durability решает, сбросить ли
+  /// буфер и нужен ли fsync.
   BinaryFileTape(const std::string &filename, const size_t sizeTape,
-                 const TapeConfig &config);
+                 const TapeConfig &config,
+                 Durability durability = Durability::None);
 
   ~BinaryFileTape() noexcept;
 
@@ -34,14 +38,44 @@ public:
 
   size_t getSize() const final;
 
+  void sync() final;
+
+  /// @brief Сбрасывает буфер потока в файл независимо от режима
+  /// надёжности — чтобы записанное увидели те, кто читает файл в обход
+  /// ленты.
+  void flush();
+
   size_t getMaxSize() const;
 
   std::string getFilename() const;
 
+  /// @brief Задержки ленты.
+  const TapeConfig &getConfig() const;
+
+  /// @brief Перечитывает размер файла после записи в обход ленты, например
+  /// позиционной записью ParallelMerger. Позиция головки не меняется.
+  void reload();
+
+  /// @brief Копирует count элементов с позиции головки source в позицию
+  /// головки этой ленты и сдвигает обе головки — как цикл read, write и
+  /// moveRight, но без поэлементных вызовов. Данные переносит ядро
+  /// (reflink, copy_file_range, sendfile), если платформа это умеет, иначе
+  /// блочное копирование через потоки. Задержки обеих лент учитываются
+  /// одной паузой за весь объём.
+  void copyFrom(BinaryFileTape &source, size_t count);
+
 private:
+  enum class StreamMode { None, Read, Write };
+
   size_t m_currentPosition;
   size_t m_size;
 
+  // Позиция файлового указателя потока и направление последней операции:
+  // при последовательном проходе поток не перепозиционируется, и буфер
+  // fstream не сбрасывается на каждом элементе.
+  size_t m_streamPosition;
+  StreamMode m_streamMode;
+
   size_t m_maxSize;
 
   std::fstream m_file;
@@ -49,7 +83,13 @@ private:
 
   TapeConfig m_config;
 
+  Durability m_durability;
+
   void updateSize();
 
+  void seekTo(StreamMode mode);
+
   void applyDelay(int delay) const;
+
+  void applyDelay(int delay, size_t count) const;
 };
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../../interfaces/TapeInterface.h"
+#include "../TapeConfig.h"
+
+#include <string>
+
+/// @brief Лента поверх файла, открытого с O_DIRECT: чтение и запись идут
+/// выровненными блоками в обход страничного кэша. Если файловая система
+/// отвергает O_DIRECT, лента продолжает работать через обычный буферизованный
+/// ввод-вывод (см. isDirect()).
+class DirectFileTape : public TapeInterface {
+public:
+  DirectFileTape(const std::string &filename, const size_t sizeTape,
+                 const TapeConfig &config,
+                 Durability durability = Durability::None);
+
+  ~DirectFileTape() noexcept;
+
+  DirectFileTape(const DirectFileTape &) = delete;
+  DirectFileTape &operator=(const DirectFileTape &) = delete;
+
+  int read() final;
+
+  void write(int data) final;
+
+  void moveLeft() final;
+
+  void moveRight() final;
+
+  void rewind() final;
+
+  bool isAtEnd() const final;
+
+  size_t getSize() const final;
+
+  void sync() final;
+
+  size_t getMaxSize() const;
+
+  std::string getFilename() const;
+
+  /// @brief true, если файл действительно открыт с O_DIRECT.
+  bool isDirect() const;
+
+  /// @brief Доступен ли бэкенд на текущей платформе: есть ли в ней
+  /// O_DIRECT.
+  static bool isSupported();
+
+private:
+  size_t m_currentPosition;
+  size_t m_size;
+
+  size_t m_maxSize;
+
+  int m_fd;
+  bool m_direct;
+
+  int *m_block;
+  size_t m_blockIndex;
+  bool m_dirty;
+
+  std::string m_filename;
+
+  TapeConfig m_config;
+
+  Durability m_durability;
+
+  void loadBlock(size_t index);
+
+  void flushBlock();
+
+  void disableDirect();
+
+  void applyDelay(int delay) const;
+};
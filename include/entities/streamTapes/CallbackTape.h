@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../../interfaces/TapeInterface.h"
+
+#include <cstddef>
+#include <functional>
+
+/// @brief Лента только для дозаписи: каждое записанное значение сразу
+/// передаётся в callback. Перезапись уже отданных значений и чтение не
+/// поддерживаются (std::logic_error).
+class CallbackTape : public TapeInterface {
+public:
+  using Sink = std::function<void(int)>;
+
+  explicit CallbackTape(Sink sink);
+
+  int read() final;
+
+  void write(int data) final;
+
+  void moveLeft() final;
+
+  void moveRight() final;
+
+  void rewind() final;
+
+  bool isAtEnd() const final;
+
+  size_t getSize() const final;
+
+private:
+  Sink m_sink;
+
+  size_t m_position = 0;
+  size_t m_size = 0;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../../interfaces/TapeInterface.h"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+/// @brief Лента только для чтения поверх генератора: значения вытягиваются
+/// по одному при движении вправо. Генератор возвращает std::nullopt, когда
+/// данные закончились. Перемотка возможна только до первого сдвига,
+/// движение влево и запись не поддерживаются (std::logic_error).
+class GeneratorTape : public TapeInterface {
+public:
+  using Generator = std::function<std::optional<int>()>;
+
+  explicit GeneratorTape(Generator generator);
+
+  int read() final;
+
+  void write(int data) final;
+
+  void moveLeft() final;
+
+  void moveRight() final;
+
+  void rewind() final;
+
+  bool isAtEnd() const final;
+
+  /// @brief Число уже прочитанных элементов: полный размер потока
+  /// неизвестен, пока он не исчерпан.
+  size_t getSize() const final;
+
+private:
+  Generator m_generator;
+
+  mutable std::optional<int> m_current;
+  mutable bool m_fetched = false;
+
+  size_t m_position = 0;
+
+  void fetch() const;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../interfaces/TapeInterface.h"
+#include "SparseIndex.h"
+
+#include <memory>
+#include <string>
+
+/// @brief Декоратор, строящий SparseIndex по записям на ленту и
+/// сохраняющий его в indexFile в каждой точке синхронизации. Сортировщики
+/// синхронизируют выход после финального слияния, поэтому индекс выхода
+/// появляется без отдельного прохода по нему.
+class IndexingTape : public TapeInterface {
+public:
+  IndexingTape(std::unique_ptr<TapeInterface> tape, std::string indexFile,
+               size_t blockElements);
+
+  int read() final;
+
+  void write(int data) final;
+
+  void moveLeft() final;
+
+  void moveRight() final;
+
+  void rewind() final;
+
+  bool isAtEnd() const final;
+
+  size_t getSize() const final;
+
+  void sync() final;
+
+  const SparseIndex &getIndex() const;
+
+private:
+  std::unique_ptr<TapeInterface> m_tape;
+  std::string m_indexFile;
+  SparseIndex m_index;
+
+  // Позиция головки: интерфейс ленты её не сообщает.
+  size_t m_position = 0;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// @brief Разреженный индекс ленты, отсортированной по возрастанию: для
+/// каждого блока из blockElements элементов — наименьший ключ и смещение
+/// начала блока.
+///
+/// Формат файла: заголовок "TIDX" и байт версии, затем blockElements, число
+/// элементов ленты и число блоков (uint64_t), затем по записи на блок —
+/// ключ (int32_t) и смещение (uint64_t).
+class SparseIndex {
+public:
+  struct Block {
+    int minKey;
+    size_t offset;
+  };
+
+  explicit SparseIndex(size_t blockElements);
+
+  /// @brief Учитывает запись value в позицию position. Блоки заполняются
+  /// по порядку, как при последовательной записи ленты.
+  void add(size_t position, int value);
+
+  size_t getBlockElements() const;
+
+  /// @brief Сколько элементов покрывает индекс.
+  size_t getElements() const;
+
+  const std::vector<Block> &getBlocks() const;
+
+  /// @brief Блок, с которого начинается поиск первого элемента не меньше
+  /// key: последний блок с ключом меньше key — равные key элементы могут
+  /// заканчивать его.
+  size_t findBlock(int key) const;
+
+  void save(const std::string &filename) const;
+
+  static SparseIndex load(const std::string &filename);
+
+  /// @brief Имя файла-спутника с индексом для файла ленты.
+  static std::string sidecarFor(const std::string &tapeFile);
+
+private:
+  size_t m_blockElements;
+  size_t m_elements = 0;
+  std::vector<Block> m_blocks;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../entities/TapeConfig.h"
+#include "../interfaces/TapeInterface.h"
+#include "SparseIndex.h"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+/// @brief Поиск по ленте, отсортированной по возрастанию, с разреженным
+/// индексом. Головка идёт к нужному блоку самым дешёвым путём — сдвигами
+/// от текущей позиции или перемоткой и сдвигами от начала, смотря что
+/// быстрее при задержках config, — и читает не больше блока. Поиск
+/// ключа стоит одного позиционирования и одного блока вместо прохода по
+/// ленте.
+class TapeSearch {
+public:
+  /// @brief Индекс должен быть построен по этой ленте. Положение головки
+  /// заранее неизвестно, поэтому первое позиционирование начинается с
+  /// перемотки.
+  TapeSearch(TapeInterface &tape, SparseIndex index, const TapeConfig &config);
+
+  /// @brief Позиция первого элемента, равного key; головка остаётся на
+  /// нём.
+  std::optional<size_t> find(int key);
+
+  /// @brief Передаёт visit элементы из [lo, hi] по возрастанию. Возвращает
+  /// их число.
+  size_t scan(int lo, int hi, const std::function<void(int)> &visit);
+
+  size_t getShifts() const;
+
+  size_t getRewinds() const;
+
+private:
+  TapeInterface &m_tape;
+  SparseIndex m_index;
+  TapeConfig m_config;
+
+  std::optional<size_t> m_position;
+
+  size_t m_shifts = 0;
+  size_t m_rewinds = 0;
+
+  /// @brief Ставит головку на первый элемент не меньше key и пишет его в
+  /// value. Возвращает false, если такого элемента нет.
+  bool seekLowerBound(int key, int &value);
+
+  void seek(size_t position);
+
+  void moveRight();
+};
@@ -13,4 +13,9 @@ public:
   virtual void rewind() = 0;
   virtual bool isAtEnd() const = 0;
   virtual size_t getSize() const = 0;
+
+  /// @brief Точка синхронизации: лента фиксирует записанное так, как
+  /// требует её режим надёжности (Durability). По умолчанию ничего не
+  /// делает.
+  virtual void sync() {}
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// @brief Операции ленты, попадающие в трассу: только те, что занимают
+/// время привода.
+enum class TraceOp : uint8_t {
+  Read = 0,
+  Write = 1,
+  MoveLeft = 2,
+  MoveRight = 3,
+  Rewind = 4,
+};
+
+inline constexpr size_t kTraceOpCount = 5;
+
+/// @brief Пишет компактную бинарную трассу операций лент.
+///
+/// Формат: заголовок "TSTR" и байт версии, затем по записи на операцию.
+/// Запись — один байт: младшие 3 бита — TraceOp, старшие 5 — номер ленты,
+/// если он меньше 31; иначе 31, а номер следует за байтом в LEB128.
+/// Запись потокобезопасна: ленты SampleSorter пишут из разных потоков.
+class TraceRecorder {
+public:
+  explicit TraceRecorder(const std::string &filename);
+  ~TraceRecorder();
+
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+  /// @brief Выдаёт номер новой ленты.
+  uint32_t registerTape();
+
+  void record(uint32_t tapeId, TraceOp op);
+
+  void flush();
+
+private:
+  static constexpr size_t kBufferSize = 64 * 1024;
+
+  std::ofstream m_file;
+  std::vector<uint8_t> m_buffer;
+
+  uint32_t m_nextTapeId = 0;
+
+  std::mutex m_mutex;
+
+  void flushLocked();
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../entities/TapeConfig.h"
+#include "TraceRecorder.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief Сводка трассы: число операций каждого вида и число лент.
+struct TraceSummary {
+  std::array<uint64_t, kTraceOpCount> counts{};
+  uint32_t tapes = 0;
+
+  uint64_t count(TraceOp op) const {
+    return counts[static_cast<size_t>(op)];
+  }
+};
+
+/// @brief Считает моделируемое время записанной трассы для других задержек
+/// без доступа к данным.
+class TraceReplayer {
+public:
+  /// @brief Читает трассу один раз, чтобы посчитать сводку; бросает
+  /// std::runtime_error на повреждённом файле.
+  explicit TraceReplayer(std::string filename);
+
+  const TraceSummary &getSummary() const;
+
+  /// @brief Время последовательного выполнения, как у BinaryFileTape:
+  /// сумма задержек всех операций. Считается по сводке без чтения файла.
+  int64_t simulate(const TapeConfig &config) const;
+
+  /// @brief Время на приводах drives; лента i работает на приводе
+  /// i % drives.size(). Операции выдаются в порядке трассы, чтение
+  /// блокирует выдачу следующей операции до своего завершения, а запись,
+  /// сдвиг и перемотка выполняются приводом в фоне, поэтому разные приводы
+  /// работают параллельно.
+  int64_t simulate(const std::vector<DriveConfig> &drives) const;
+
+  /// @brief То же для driveCount одинаковых приводов с задержками config.
+  int64_t simulate(const TapeConfig &config, size_t driveCount) const;
+
+private:
+  const std::string m_filename;
+  TraceSummary m_summary;
+
+  template <typename Visitor> void forEach(Visitor &&visitor) const;
+};
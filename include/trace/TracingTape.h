@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../interfaces/TapeInterface.h"
+#include "TraceRecorder.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// @brief Декоратор, записывающий операции ленты в TraceRecorder. Чтобы
+/// трассировать чужую ленту, не забирая владение, её можно обернуть в
+/// TapeView.
+///
+/// Сдвиг, который файловая лента не выполняет (влево от начала, вправо за
+/// максимальный размер), не занимает привод и в трассу не попадает. Для
+/// этого декоратор сам следит за позицией головки, поэтому ленту нужно
+/// оборачивать с головкой в начале.
+class TracingTape : public TapeInterface {
+public:
+  TracingTape(std::unique_ptr<TapeInterface> tape, TraceRecorder &recorder);
+
+  int read() final;
+
+  void write(int data) final;
+
+  void moveLeft() final;
+
+  void moveRight() final;
+
+  void rewind() final;
+
+  bool isAtEnd() const final;
+
+  size_t getSize() const final;
+
+  void sync() final;
+
+  uint32_t getTapeId() const;
+
+private:
+  std::unique_ptr<TapeInterface> m_tape;
+  TraceRecorder &m_recorder;
+  const uint32_t m_tapeId;
+  /// Максимальный размер файловой ленты; у остальных лент не ограничен.
+  const size_t m_maxSize;
+  size_t m_position = 0;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../entities/TapeSorter.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+enum class SortMode {
+  Sort,
+  TopK,
+  Merge,
+  SampleSort,
+  Daemon,
+  Replay,
+  Lookup,
+  Sketch,
+  Verify
+};
+
+/// @brief Порядок сортировки из --order; выбирает один из заранее
+/// инстанцированных BasicTapeSorter.
+enum class OrderOption { Ascending, Descending, Magnitude };
+
+/// @brief Корзин гистограммы в --sketch-only, если --sketch не задан.
+inline constexpr size_t kDefaultSketchBins = 16;
+
+struct CliOptions {
+  SortMode mode = SortMode::Sort;
+
+  std::string inputFile;
+  std::string outputFile;
+  std::string configFile;
+
+  size_t topK = 0;
+
+  std::vector<std::string> mergeInputs;
+  bool assumeSorted = false;
+
+  size_t partitions = 0;
+  bool keepPartitions = false;
+
+  MergeStrategy mergeStrategy = MergeStrategy::Pairwise;
+  OrderOption order = OrderOption::Ascending;
+  bool stable = false;
+  size_t mergeThreads = 0;
+  bool printStats = false;
+
+  // Размер блока разреженного индекса выхода; 0 — индекс не строится.
+  size_t indexBlock = 0;
+
+  // Число корзин гистограммы эскиза входа; 0 — эскиз не собирается.
+  size_t sketchBins = 0;
+
+  // Проверять порядок и контрольную сумму выхода при сортировке.
+  bool verify = false;
+
+  std::string spoolDir;
+  size_t workers = 0;
+  size_t memoryBudget = 0;
+  size_t tempDiskBudget = 0;
+  bool once = false;
+
+  std::string traceFile;
+  std::string replayFile;
+  size_t replayDrives = 0;
+
+  std::string lookupFile;
+  int lookupLo = 0;
+  int lookupHi = 0;
+};
+
+/// @brief Разбирает имя стратегии: pairwise, backward, async или forecast.
+MergeStrategy parseMergeStrategy(const std::string &value);
+
+/// @brief Разбирает порядок: asc, desc или abs.
+OrderOption parseOrder(const std::string &value);
+
+CliOptions parseArguments(int argc, const char *const argv[]);
+
+std::string usage(const std::string &program);
+
+} // namespace utils
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+/// @brief Векторные ядра для int32: слияние двух отсортированных блоков
+/// битонической сетью и сортировка небольших серий в регистрах. Набор
+/// инструкций выбирается во время выполнения (AVX2, SSE4.1 или скалярный
+/// код), поэтому бинарник не требует AVX2 от целевой машины.
+namespace utils::simd {
+
+enum class Isa { Scalar, Sse41, Avx2 };
+
+/// @brief Лучший набор инструкций, поддерживаемый процессором.
+Isa detectIsa();
+
+const char *isaName(Isa isa);
+
+/// @brief Сливает отсортированные a и b в out (na + nb элементов, out не
+/// должен пересекаться с входами). Если isa не поддерживается процессором,
+/// используется лучший доступный.
+void merge(const int *a, size_t na, const int *b, size_t nb, int *out,
+           Isa isa);
+
+void merge(const int *a, size_t na, const int *b, size_t nb, int *out);
+
+/// @brief Наибольший размер серии, которую sort() сортирует в регистрах;
+/// более длинные серии сортируются std::sort.
+inline constexpr size_t kMaxSmallSort = 1024;
+
+/// @brief Сортирует data по возрастанию: блоки по 8 (AVX2) или 4 (SSE4.1)
+/// элемента сортирующей сетью в регистрах, затем восходящее слияние
+/// через merge(). Дополнительная память — буфер на стеке размера
+/// kMaxSmallSort.
+void sort(int *data, size_t n, Isa isa);
+
+void sort(int *data, size_t n);
+
+} // namespace utils::simd
@@ -1,9 +1,10 @@
 #pragma once
 
+#include "../entities/TapeConfig.h"
+
 #include <memory>
 #include <string>
 
-struct TapeConfig;
 class TapeInterface;
 
 namespace utils {
@@ -15,7 +16,24 @@ std::string getFileExtension(const std::string &filename);
 std::unique_ptr<TapeInterface> createTape(const size_t maxSize,
                                           const TapeConfig &config,
                                           const std::string &filename,
-                                          const std::string &ext);
+                                          const std::string &ext,
+                                          bool directIo = false,
+                                          Durability durability =
+                                              Durability::None);
+
+/// @brief Создаёт бинарную файловую ленту; при directIo и поддержке
+/// платформой — DirectFileTape, иначе BinaryFileTape. durability — что
+/// лента делает в точках синхронизации.
+std::unique_ptr<TapeInterface>
+createFileTape(const size_t maxSize, const TapeConfig &config,
+               const std::string &filename, bool directIo,
+               Durability durability = Durability::None);
+
+/// @brief Копирует count элементов с позиции головки from в позицию
+/// головки to, сдвигая обе. Файловые ленты BinaryFileTape (в том числе за
+/// TapeView) копируются целиком через BinaryFileTape::copyFrom, остальные —
+/// поэлементно.
+void copyTape(TapeInterface &from, TapeInterface &to, size_t count);
 
 void clearFile(const std::string &filename);
 
@@ -0,0 +1,29 @@
+#include "../../include/async/AsyncTape.h"
+
+AsyncTape::AsyncTape(TapeScheduler &scheduler, TapeInterface &tape,
+                     const TapeConfig &delays)
+    : m_ownDrive(std::make_unique<TapeDrive>(scheduler, delays)),
+      m_drive(*m_ownDrive), m_tape(tape) {}
+
+AsyncTape::AsyncTape(TapeDrive &drive, TapeInterface &tape)
+    : m_drive(drive), m_tape(tape) {}
+
+void AsyncTape::writeBehind(int data) {
+  m_drive.reserve(delays().writeDelay);
+  m_tape.write(data);
+}
+
+void AsyncTape::moveRightBehind() {
+  m_drive.reserve(delays().shiftDelay);
+  m_tape.moveRight();
+}
+
+bool AsyncTape::isAtEnd() const { return m_tape.isAtEnd(); }
+
+size_t AsyncTape::getSize() const { return m_tape.getSize(); }
+
+TapeScheduler::Milliseconds AsyncTape::getBusyUntil() const {
+  return m_drive.getBusyUntil();
+}
+
+TapeDrive &AsyncTape::getDrive() const { return m_drive; }
@@ -0,0 +1,22 @@
+#include "../../include/async/TapeDrive.h"
+
+#include <algorithm>
+
+TapeDrive::TapeDrive(TapeScheduler &scheduler, const TapeConfig &delays)
+    : m_scheduler(scheduler), m_delays(delays) {}
+
+TapeScheduler &TapeDrive::getScheduler() const { return m_scheduler; }
+
+const TapeConfig &TapeDrive::getDelays() const { return m_delays; }
+
+TapeScheduler::Milliseconds TapeDrive::getBusyUntil() const {
+  return m_busyUntil;
+}
+
+TapeScheduler::Milliseconds TapeDrive::reserve(int delay) {
+  const TapeScheduler::Milliseconds start =
+      std::max(m_scheduler.now(), m_busyUntil);
+
+  m_busyUntil = start + std::max(delay, 0);
+  return m_busyUntil;
+}
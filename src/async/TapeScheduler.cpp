@@ -0,0 +1,41 @@
+#include "../../include/async/TapeScheduler.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+TapeScheduler::TapeScheduler(bool realTime)
+    : m_realTime(realTime), m_start(std::chrono::steady_clock::now()) {}
+
+void TapeScheduler::spawn(Task task) {
+  schedule(task.handle(), m_now);
+  m_tasks.push_back(std::move(task));
+}
+
+void TapeScheduler::run() {
+  while (!m_timers.empty()) {
+    Timer timer = m_timers.top();
+    m_timers.pop();
+
+    if (m_realTime && timer.at > m_now) {
+      std::this_thread::sleep_until(m_start +
+                                    std::chrono::milliseconds(timer.at));
+    }
+
+    m_now = std::max(m_now, timer.at);
+    timer.handle.resume();
+  }
+
+  std::vector<Task> finished = std::move(m_tasks);
+  m_tasks.clear();
+
+  for (const auto &task : finished) {
+    task.rethrowIfFailed();
+  }
+}
+
+void TapeScheduler::schedule(std::coroutine_handle<> handle, Milliseconds at) {
+  m_timers.push(Timer{at, m_sequence++, handle});
+}
+
+TapeScheduler::Milliseconds TapeScheduler::now() const { return m_now; }
@@ -0,0 +1,98 @@
+#include "../../include/daemon/JobDescriptor.h"
+#include "../../include/utils/cliOptions.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string trimmed(const std::string &s) {
+  constexpr std::string_view whitespace = " \t\n\r\f\v";
+
+  const size_t begin = s.find_first_not_of(whitespace);
+  if (begin == std::string::npos) {
+    return "";
+  }
+
+  return s.substr(begin, s.find_last_not_of(whitespace) - begin + 1);
+}
+
+size_t parseSize(const std::string &key, const std::string &value) {
+  size_t pos = 0;
+  unsigned long long result = 0;
+
+  try {
+    result = std::stoull(value, &pos);
+  } catch (const std::exception &) {
+    pos = 0;
+  }
+
+  if (pos != value.size() || value.empty() || value[0] == '-') {
+    throw std::runtime_error("Invalid value for " + key + ": " + value);
+  }
+
+  return static_cast<size_t>(result);
+}
+
+} // namespace
+
+JobDescriptor parseJobDescriptor(const std::string &path) {
+  std::ifstream file(path);
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open job file: " + path);
+  }
+
+  JobDescriptor job;
+  job.name = fs::path(path).stem().string();
+
+  std::string line;
+  size_t lineNumber = 0;
+
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    line = trimmed(line);
+
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    const size_t eq = line.find('=');
+    if (eq == std::string::npos) {
+      throw std::runtime_error(path + ":" + std::to_string(lineNumber) +
+                               ": expected key = value");
+    }
+
+    const std::string key = trimmed(line.substr(0, eq));
+    const std::string value = trimmed(line.substr(eq + 1));
+
+    if (key == "input") {
+      job.inputFile = value;
+    } else if (key == "output") {
+      job.outputFile = value;
+    } else if (key == "memory_limit") {
+      job.memoryLimit = parseSize(key, value);
+    } else if (key == "top_k") {
+      job.topK = parseSize(key, value);
+    } else if (key == "merge_strategy") {
+      try {
+        job.mergeStrategy = utils::parseMergeStrategy(value);
+      } catch (const std::invalid_argument &e) {
+        throw std::runtime_error(e.what());
+      }
+    } else {
+      throw std::runtime_error("Unknown job key: " + key);
+    }
+  }
+
+  if (job.inputFile.empty() || job.outputFile.empty()) {
+    throw std::runtime_error("Job " + job.name +
+                             " must specify input and output");
+  }
+
+  return job;
+}
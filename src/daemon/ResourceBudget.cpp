@@ -0,0 +1,42 @@
+#include "../../include/daemon/ResourceBudget.h"
+
+#include <stdexcept>
+#include <string>
+
+ResourceBudget::ResourceBudget(size_t capacity)
+    : m_capacity(capacity), m_available(capacity) {}
+
+void ResourceBudget::acquire(size_t amount) {
+  if (amount > m_capacity) {
+    throw std::invalid_argument("Requested " + std::to_string(amount) +
+                                " bytes, budget is " +
+                                std::to_string(m_capacity));
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_released.wait(lock, [&] { return m_available >= amount; });
+  m_available -= amount;
+}
+
+void ResourceBudget::release(size_t amount) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_available += amount;
+  }
+
+  m_released.notify_all();
+}
+
+size_t ResourceBudget::getCapacity() const { return m_capacity; }
+
+size_t ResourceBudget::getAvailable() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_available;
+}
+
+ResourceBudget::Lease::Lease(ResourceBudget &budget, size_t amount)
+    : m_budget(budget), m_amount(amount) {
+  m_budget.acquire(m_amount);
+}
+
+ResourceBudget::Lease::~Lease() { m_budget.release(m_amount); }
@@ -0,0 +1,304 @@
+#include "../../include/daemon/SortDaemon.h"
+#include "../../include/entities/TapeSorter.h"
+#include "../../include/interfaces/TapeInterface.h"
+#include "../../include/utils/utils.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+int64_t millisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+SortDaemon::SortDaemon(TapeConfig config, DaemonOptions options)
+    : m_config(std::move(config)), m_options(std::move(options)),
+      m_memory(m_options.memoryBudget), m_tempDisk(m_options.tempDiskBudget) {
+  if (m_options.workers == 0) {
+    throw std::invalid_argument("Daemon needs at least one worker");
+  }
+
+  if (m_options.memoryBudget < sizeof(int)) {
+    throw std::invalid_argument("Memory budget is too small");
+  }
+
+  if (!fs::is_directory(m_options.spoolDir)) {
+    throw std::runtime_error("Spool directory does not exist: " +
+                             m_options.spoolDir);
+  }
+
+  m_tmpDir = claimTmpDir(m_options.tmpDir);
+
+  for (size_t i = 0; i < m_options.workers; ++i) {
+    m_workers.emplace_back([this, i] { workerLoop(i); });
+  }
+}
+
+SortDaemon::~SortDaemon() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+
+  m_jobAvailable.notify_all();
+
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+
+  // Рабочие удаляют только свои подкаталоги после каждого задания.
+  std::error_code error;
+  fs::remove_all(m_tmpDir, error);
+
+  for (const std::string &root : m_config.tempDirs) {
+    fs::remove_all(fs::path(root) / fs::path(m_tmpDir).relative_path(), error);
+  }
+}
+
+std::string SortDaemon::claimTmpDir(const std::string &parent) {
+  fs::create_directories(parent);
+
+  std::random_device device;
+  std::mt19937_64 rng((static_cast<uint64_t>(device()) << 32) ^ device());
+
+  // create_directory возвращает false, если каталог уже есть, поэтому два
+  // демона не займут один и тот же.
+  for (int attempt = 0; attempt < 100; ++attempt) {
+    std::ostringstream name;
+    name << "daemon_" << std::hex << std::setw(16) << std::setfill('0')
+         << rng();
+
+    const fs::path candidate = fs::path(parent) / name.str();
+    if (fs::create_directory(candidate)) {
+      return candidate.string();
+    }
+  }
+
+  throw std::runtime_error("Failed to create a temporary directory in " +
+                           parent);
+}
+
+size_t SortDaemon::poll() {
+  std::vector<fs::path> jobs;
+
+  for (const auto &entry : fs::directory_iterator(m_options.spoolDir)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".job") {
+      jobs.push_back(entry.path());
+    }
+  }
+
+  // Задания выполняются в порядке имён.
+  std::sort(jobs.begin(), jobs.end());
+
+  size_t claimed = 0;
+
+  for (const auto &job : jobs) {
+    fs::path running = job;
+    running.replace_extension(".running");
+
+    // Если файл уже забрал другой демон, переименование не удастся.
+    std::error_code error;
+    fs::rename(job, running, error);
+    if (error) {
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_queue.push_back(running.string());
+    }
+
+    m_jobAvailable.notify_one();
+    ++claimed;
+  }
+
+  return claimed;
+}
+
+void SortDaemon::waitIdle() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [&] { return m_queue.empty() && m_active == 0; });
+}
+
+void SortDaemon::serve(const std::function<bool()> &shouldStop) {
+  while (!shouldStop()) {
+    poll();
+    std::this_thread::sleep_for(m_options.pollInterval);
+  }
+
+  waitIdle();
+}
+
+void SortDaemon::setJobCallback(
+    std::function<void(const JobMetrics &)> callback) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_callback = std::move(callback);
+}
+
+std::vector<JobMetrics> SortDaemon::getMetrics() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_metrics;
+}
+
+void SortDaemon::workerLoop(size_t index) {
+  TapeSorter sorter(m_config.memoryLimit, m_config,
+                    m_tmpDir + "/worker_" + std::to_string(index));
+
+  while (true) {
+    std::string claimedPath;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_jobAvailable.wait(lock,
+                          [&] { return m_stopping || !m_queue.empty(); });
+
+      if (m_queue.empty()) {
+        return;
+      }
+
+      claimedPath = std::move(m_queue.front());
+      m_queue.pop_front();
+      ++m_active;
+    }
+
+    const JobMetrics metrics = runJob(sorter, claimedPath);
+    report(claimedPath, metrics);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_metrics.push_back(metrics);
+      --m_active;
+
+      if (m_callback) {
+        m_callback(metrics);
+      }
+    }
+
+    m_idle.notify_all();
+  }
+}
+
+JobMetrics SortDaemon::runJob(TapeSorter &sorter,
+                              const std::string &claimedPath) {
+  JobMetrics metrics;
+  metrics.name = fs::path(claimedPath).stem().string();
+
+  const auto claimedAt = std::chrono::steady_clock::now();
+
+  try {
+    const JobDescriptor job = parseJobDescriptor(claimedPath);
+
+    const std::string inputExt = utils::getFileExtension(job.inputFile);
+    const std::string outputExt = utils::getFileExtension(job.outputFile);
+    utils::validateExtensions(inputExt, outputExt);
+
+    // Лента создала бы отсутствующий файл и «отсортировала» пустой вход.
+    if (!fs::is_regular_file(job.inputFile)) {
+      throw std::runtime_error("Input file does not exist: " + job.inputFile);
+    }
+
+    const size_t inputFileSize = utils::getFileSize(job.inputFile);
+    auto inputTape = utils::createTape(inputFileSize, m_config, job.inputFile,
+                                       inputExt, m_config.inputDirectIo);
+
+    metrics.elements = inputTape->getSize();
+    metrics.memoryBytes =
+        std::min(job.memoryLimit != 0 ? job.memoryLimit : m_config.memoryLimit,
+                 m_memory.getCapacity());
+
+    if (metrics.memoryBytes < sizeof(int)) {
+      throw std::runtime_error("memory_limit is too small");
+    }
+
+    metrics.tempDiskBytes =
+        estimateTempDisk(metrics.elements, metrics.memoryBytes);
+
+    // Память всегда берётся раньше диска, поэтому рабочие не могут
+    // заблокировать друг друга, держа по одному ресурсу.
+    ResourceBudget::Lease memory(m_memory, metrics.memoryBytes);
+    ResourceBudget::Lease tempDisk(m_tempDisk, metrics.tempDiskBytes);
+
+    metrics.waitMs = millisecondsSince(claimedAt);
+    const auto startedAt = std::chrono::steady_clock::now();
+
+    utils::clearFile(job.outputFile);
+    auto outputTape =
+        utils::createTape(inputFileSize, m_config, job.outputFile, outputExt,
+                          m_config.outputDirectIo, m_config.outputDurability);
+
+    sorter.setMemoryLimit(metrics.memoryBytes);
+    sorter.setMergeStrategy(job.mergeStrategy);
+
+    if (job.topK != 0) {
+      sorter.sortTopK(*inputTape, *outputTape, job.topK);
+    } else {
+      sorter.sort(*inputTape, *outputTape);
+    }
+
+    metrics.runMs = millisecondsSince(startedAt);
+    metrics.stats = sorter.getStats();
+    metrics.succeeded = true;
+
+  } catch (const std::exception &e) {
+    metrics.error = e.what();
+  }
+
+  return metrics;
+}
+
+size_t SortDaemon::estimateTempDisk(size_t elements, size_t memoryLimit) {
+  const size_t maxElements = memoryLimit / sizeof(int);
+
+  if (elements <= maxElements) {
+    return 0;
+  }
+
+  size_t levels = 0;
+  for (size_t runs = (elements + maxElements - 1) / maxElements; runs > 1;
+       runs = (runs + 1) / 2) {
+    ++levels;
+  }
+
+  return elements * sizeof(int) * levels;
+}
+
+void SortDaemon::report(const std::string &claimedPath,
+                        const JobMetrics &metrics) {
+  fs::path result = claimedPath;
+  result.replace_extension(metrics.succeeded ? ".done" : ".failed");
+
+  {
+    std::ofstream file(result);
+
+    if (metrics.succeeded) {
+      file << "elements = " << metrics.elements << '\n'
+           << "memory_bytes = " << metrics.memoryBytes << '\n'
+           << "temp_disk_bytes = " << metrics.tempDiskBytes << '\n'
+           << "wait_ms = " << metrics.waitMs << '\n'
+           << "run_ms = " << metrics.runMs << '\n'
+           << "runs = " << metrics.stats.runs << '\n'
+           << "merge_passes = " << metrics.stats.mergePasses << '\n'
+           << "rewinds = " << metrics.stats.rewinds << '\n';
+    } else {
+      file << "error = " << metrics.error << '\n';
+    }
+  }
+
+  std::error_code error;
+  fs::remove(claimedPath, error);
+}
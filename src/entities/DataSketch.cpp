@@ -0,0 +1,225 @@
+#include "../../include/entities/DataSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+int64_t floorDiv(int64_t a, int64_t b) {
+  const int64_t q = a / b;
+  return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+} // namespace
+
+KllSketch::KllSketch(size_t k, uint64_t seed)
+    : m_k(k), m_levels(1), m_random(seed) {
+  if (k < 2) {
+    throw std::invalid_argument("KLL parameter k must be at least 2");
+  }
+
+  m_limit = capacity(0);
+}
+
+void KllSketch::add(int value) {
+  if (m_count == 0) {
+    m_min = value;
+    m_max = value;
+  } else {
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+  }
+
+  ++m_count;
+  ++m_retained;
+  m_levels[0].push_back(value);
+
+  if (m_retained > m_limit) {
+    compress();
+  }
+}
+
+size_t KllSketch::getCount() const { return m_count; }
+
+size_t KllSketch::getRetained() const { return m_retained; }
+
+int KllSketch::getMin() const { return m_min; }
+
+int KllSketch::getMax() const { return m_max; }
+
+int KllSketch::quantile(double q) const {
+  if (m_count == 0) {
+    throw std::logic_error("Quantile of an empty sketch");
+  }
+
+  if (q <= 0) {
+    return m_min;
+  }
+
+  if (q >= 1) {
+    return m_max;
+  }
+
+  std::vector<std::pair<int, uint64_t>> weighted;
+  uint64_t total = 0;
+
+  for (size_t level = 0; level < m_levels.size(); ++level) {
+    for (int value : m_levels[level]) {
+      weighted.emplace_back(value, uint64_t{1} << level);
+      total += uint64_t{1} << level;
+    }
+  }
+
+  std::sort(weighted.begin(), weighted.end());
+
+  const auto target =
+      static_cast<uint64_t>(std::ceil(q * static_cast<double>(total)));
+  uint64_t cumulative = 0;
+
+  for (const auto &[value, weight] : weighted) {
+    cumulative += weight;
+
+    if (cumulative >= target) {
+      return value;
+    }
+  }
+
+  return m_max;
+}
+
+size_t KllSketch::rank(int value) const {
+  uint64_t rank = 0;
+
+  for (size_t level = 0; level < m_levels.size(); ++level) {
+    for (int x : m_levels[level]) {
+      if (x <= value) {
+        rank += uint64_t{1} << level;
+      }
+    }
+  }
+
+  return static_cast<size_t>(rank);
+}
+
+size_t KllSketch::capacity(size_t level) const {
+  // Верхний уровень вмещает k, каждый следующий вниз — в 2/3 раза меньше.
+  const size_t depth = m_levels.size() - 1 - level;
+  const double scaled =
+      std::ceil(static_cast<double>(m_k) * std::pow(2.0 / 3.0, depth));
+
+  return std::max<size_t>(2, static_cast<size_t>(scaled));
+}
+
+void KllSketch::compress() {
+  for (size_t level = 0; level < m_levels.size(); ++level) {
+    if (m_levels[level].size() < capacity(level)) {
+      continue;
+    }
+
+    if (level + 1 == m_levels.size()) {
+      m_levels.emplace_back();
+
+      m_limit = 0;
+      for (size_t i = 0; i < m_levels.size(); ++i) {
+        m_limit += capacity(i);
+      }
+    }
+
+    std::vector<int> &items = m_levels[level];
+    std::sort(items.begin(), items.end());
+
+    // При нечётном размере один элемент остаётся на уровне.
+    int kept = 0;
+    const bool odd = items.size() % 2 != 0;
+    if (odd) {
+      kept = items.back();
+      items.pop_back();
+    }
+
+    const size_t offset = m_random() & 1;
+    for (size_t i = offset; i < items.size(); i += 2) {
+      m_levels[level + 1].push_back(items[i]);
+    }
+
+    m_retained -= items.size() / 2;
+
+    items.clear();
+    if (odd) {
+      items.push_back(kept);
+    }
+
+    return;
+  }
+}
+
+EquiWidthHistogram::EquiWidthHistogram(size_t bins) : m_counts(bins, 0) {
+  // Одна выровненная корзина не накроет значения по обе стороны от нуля.
+  if (bins < 2) {
+    throw std::invalid_argument("Histogram must have at least two bins");
+  }
+}
+
+void EquiWidthHistogram::add(int value, size_t count) {
+  if (m_empty) {
+    m_min = value;
+    m_max = value;
+    m_low = value;
+    m_empty = false;
+  }
+
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+
+  const auto bins = static_cast<int64_t>(m_counts.size());
+
+  while (m_max >= floorDiv(m_min, m_width) * m_width + m_width * bins) {
+    widen();
+  }
+
+  // Первая корзина всегда начинается у минимума, выровненного по ширине.
+  const int64_t low = floorDiv(m_min, m_width) * m_width;
+
+  if (low < m_low) {
+    const auto shift = static_cast<size_t>((m_low - low) / m_width);
+
+    // Верхние корзины пусты: иначе диапазон не поместился бы и ширина
+    // удвоилась бы выше.
+    std::rotate(m_counts.rbegin(), m_counts.rbegin() + shift,
+                m_counts.rend());
+    m_low = low;
+  }
+
+  m_counts[static_cast<size_t>((value - m_low) / m_width)] += count;
+}
+
+int64_t EquiWidthHistogram::getLow() const { return m_low; }
+
+int64_t EquiWidthHistogram::getWidth() const { return m_width; }
+
+const std::vector<size_t> &EquiWidthHistogram::getCounts() const {
+  return m_counts;
+}
+
+void EquiWidthHistogram::widen() {
+  // Новые корзины выровнены по кратным новой ширины, поэтому каждая
+  // старая корзина целиком попадает в одну новую.
+  const int64_t width = m_width * 2;
+  const int64_t low = floorDiv(m_low, width) * width;
+
+  std::vector<size_t> counts(m_counts.size(), 0);
+
+  for (size_t i = 0; i < m_counts.size(); ++i) {
+    if (m_counts[i] == 0) {
+      continue;
+    }
+
+    const int64_t start = m_low + static_cast<int64_t>(i) * m_width;
+    counts[static_cast<size_t>((start - low) / width)] += m_counts[i];
+  }
+
+  m_low = low;
+  m_width = width;
+  m_counts = std::move(counts);
+}
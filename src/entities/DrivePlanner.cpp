@@ -0,0 +1,130 @@
+#include "../../include/entities/DrivePlanner.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+DrivePlanner::DrivePlanner(std::vector<DriveConfig> drives)
+    : m_drives(std::move(drives)), m_loads(m_drives.size(), 0) {
+  if (m_drives.empty()) {
+    throw std::invalid_argument("DrivePlanner requires at least one drive");
+  }
+}
+
+size_t DrivePlanner::placeRun(size_t length) {
+  const size_t drive =
+      cheapestDrive(length, std::vector<bool>(m_drives.size(), false));
+
+  m_loads[drive] += writeCost(drive, length);
+  return drive;
+}
+
+std::vector<std::vector<PlannedMerge>>
+DrivePlanner::planLevel(const std::vector<PlacedRun> &runs) {
+  // Серии с одного привода сливаются между собой: тогда слиянию нужен
+  // только один читаемый привод, и выходу остаётся больше вариантов.
+  std::vector<size_t> order(runs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return runs[a].drive < runs[b].drive;
+  });
+
+  std::vector<std::pair<size_t, size_t>> pending;
+  for (size_t i = 0; i + 1 < order.size(); i += 2) {
+    pending.emplace_back(order[i], order[i + 1]);
+  }
+
+  std::vector<std::vector<PlannedMerge>> steps;
+
+  while (!pending.empty()) {
+    std::vector<PlannedMerge> step;
+    std::vector<bool> reading(m_drives.size(), false);
+    std::vector<bool> writing(m_drives.size(), false);
+    std::vector<std::pair<size_t, size_t>> deferred;
+
+    for (const auto &[first, second] : pending) {
+      const size_t drive1 = runs[first].drive;
+      const size_t drive2 = runs[second].drive;
+      const size_t length = runs[first].length + runs[second].length;
+
+      if (writing[drive1] || writing[drive2]) {
+        deferred.emplace_back(first, second);
+        continue;
+      }
+
+      std::vector<bool> excluded = reading;
+      excluded[drive1] = true;
+      excluded[drive2] = true;
+
+      size_t output = cheapestDrive(length, excluded);
+
+      if (output == m_drives.size()) {
+        if (!step.empty()) {
+          deferred.emplace_back(first, second);
+          continue;
+        }
+
+        // Свободного привода нет вовсе (например, он один): слияние идёт
+        // отдельным шагом, чтение и запись на одном приводе чередуются.
+        output = cheapestDrive(length, std::vector<bool>(m_drives.size(),
+                                                         false));
+      }
+
+      reading[drive1] = true;
+      reading[drive2] = true;
+      writing[output] = true;
+
+      m_loads[drive1] += readCost(drive1, runs[first].length);
+      m_loads[drive2] += readCost(drive2, runs[second].length);
+      m_loads[output] += writeCost(output, length);
+
+      step.push_back({first, second, output});
+    }
+
+    steps.push_back(std::move(step));
+    pending = std::move(deferred);
+  }
+
+  return steps;
+}
+
+size_t DrivePlanner::getDriveCount() const { return m_drives.size(); }
+
+int64_t DrivePlanner::getLoad(size_t drive) const { return m_loads[drive]; }
+
+int64_t DrivePlanner::readCost(size_t drive, size_t length) const {
+  const DriveConfig &config = m_drives[drive];
+  return static_cast<int64_t>(length) *
+             (config.readDelay + config.shiftDelay) +
+         config.rewindDelay;
+}
+
+int64_t DrivePlanner::writeCost(size_t drive, size_t length) const {
+  const DriveConfig &config = m_drives[drive];
+  return static_cast<int64_t>(length) *
+             (config.writeDelay + config.shiftDelay) +
+         config.rewindDelay;
+}
+
+size_t DrivePlanner::cheapestDrive(size_t length,
+                                   const std::vector<bool> &excluded) const {
+  size_t best = m_drives.size();
+  int64_t bestFinish = std::numeric_limits<int64_t>::max();
+
+  for (size_t drive = 0; drive < m_drives.size(); ++drive) {
+    if (excluded[drive]) {
+      continue;
+    }
+
+    const int64_t finish = m_loads[drive] + writeCost(drive, length);
+
+    if (finish < bestFinish) {
+      best = drive;
+      bestFinish = finish;
+    }
+  }
+
+  return best;
+}
@@ -0,0 +1,135 @@
+#include "../../include/entities/ForecastingMerger.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+ForecastingMerger::ForecastingMerger(std::vector<TapeInterface *> inputs,
+                                     size_t blockElements)
+    : m_blockElements(blockElements) {
+  if (blockElements == 0) {
+    throw std::invalid_argument("Block size must be positive");
+  }
+
+  for (TapeInterface *tape : inputs) {
+    m_inputs.push_back({tape, tape->getSize(), {}});
+  }
+}
+
+ForecastingMerger::~ForecastingMerger() {
+  // Фоновое чтение держит ссылки на ленты и буферы.
+  if (m_prefetch.valid()) {
+    m_prefetch.wait();
+  }
+}
+
+void ForecastingMerger::readBlock(Input &input, std::vector<int> &block,
+                                  size_t blockElements) {
+  const size_t size = std::min(input.remaining, blockElements);
+
+  block.clear();
+  for (size_t i = 0; i < size; ++i) {
+    block.push_back(input.tape->read());
+    input.tape->moveRight();
+  }
+
+  input.remaining -= size;
+}
+
+void ForecastingMerger::startPrefetch() {
+  // Прогноз: блок с наименьшим последним ключом (при равенстве — с
+  // меньшим номером, как и в куче слияния) опустеет первым.
+  size_t next = kNone;
+
+  for (size_t i = 0; i < m_inputs.size(); ++i) {
+    const Input &input = m_inputs[i];
+
+    if (input.remaining == 0 || input.pos == input.block.size()) {
+      continue;
+    }
+
+    if (next == kNone || input.block.back() < m_inputs[next].block.back()) {
+      next = i;
+    }
+  }
+
+  if (next == kNone) {
+    return;
+  }
+
+  m_spareOwner = next;
+  m_prefetch = std::async(std::launch::async, readBlock,
+                          std::ref(m_inputs[next]), std::ref(m_spare),
+                          m_blockElements);
+}
+
+void ForecastingMerger::refill(size_t index) {
+  Input &input = m_inputs[index];
+  input.pos = 0;
+
+  if (m_spareOwner == index) {
+    m_prefetch.get();
+    m_spareOwner = kNone;
+
+    std::swap(input.block, m_spare);
+    ++m_prefetched;
+
+    startPrefetch();
+    return;
+  }
+
+  // При верном прогнозе сюда не попасть; освободившийся блок входа
+  // заполняется синхронно, запасной блок остаётся за своим входом.
+  readBlock(input, input.block, m_blockElements);
+  ++m_misses;
+}
+
+size_t ForecastingMerger::merge(TapeInterface &output, size_t limit) {
+  using Head = std::pair<int, size_t>;
+  std::priority_queue<Head, std::vector<Head>, std::greater<>> heads;
+
+  for (size_t i = 0; i < m_inputs.size(); ++i) {
+    readBlock(m_inputs[i], m_inputs[i].block, m_blockElements);
+
+    if (!m_inputs[i].block.empty()) {
+      heads.emplace(m_inputs[i].block.front(), i);
+    }
+  }
+
+  startPrefetch();
+
+  size_t written = 0;
+
+  for (; written < limit && !heads.empty(); ++written) {
+    const auto [value, index] = heads.top();
+    heads.pop();
+
+    output.write(value);
+    output.moveRight();
+
+    Input &input = m_inputs[index];
+
+    if (++input.pos == input.block.size()) {
+      // remaining входа с заказанным блоком меняет фоновый поток.
+      if (m_spareOwner != index && input.remaining == 0) {
+        continue;
+      }
+
+      refill(index);
+    }
+
+    heads.emplace(input.block[input.pos], index);
+  }
+
+  if (m_prefetch.valid()) {
+    m_prefetch.get();
+  }
+
+  return written;
+}
+
+size_t ForecastingMerger::getPrefetched() const { return m_prefetched; }
+
+size_t ForecastingMerger::getMisses() const { return m_misses; }
@@ -0,0 +1,384 @@
+#include "../../include/entities/ParallelMerger.h"
+#include "../../include/utils/simdKernels.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::streamoff offsetOf(size_t index) {
+  return static_cast<std::streamoff>(index) *
+         static_cast<std::streamoff>(sizeof(int));
+}
+
+/// @brief Буферизованное чтение элементов [begin, end) файла серии.
+class RangeReader {
+public:
+  RangeReader(const std::string &filename, size_t begin, size_t end,
+              size_t bufferElements)
+      : m_file(filename, std::ios::binary), m_filename(filename),
+        m_next(begin), m_end(end), m_buffer(bufferElements) {
+    if (!m_file.is_open()) {
+      throw std::runtime_error("Failed to open run file: " + filename);
+    }
+
+    m_file.seekg(offsetOf(begin));
+  }
+
+  /// @brief Возвращает false, если диапазон исчерпан.
+  bool next(int &value) {
+    if (m_pos == m_count && !fill()) {
+      return false;
+    }
+
+    value = m_buffer[m_pos++];
+    return true;
+  }
+
+  /// @brief Ещё не выданные элементы буфера; пусто, только если диапазон
+  /// исчерпан.
+  std::span<const int> block() {
+    if (m_pos == m_count) {
+      fill();
+    }
+
+    return {m_buffer.data() + m_pos, m_count - m_pos};
+  }
+
+  void consume(size_t count) { m_pos += count; }
+
+private:
+  bool fill() {
+    if (m_next == m_end) {
+      return false;
+    }
+
+    m_count = std::min(m_buffer.size(), m_end - m_next);
+    m_file.read(reinterpret_cast<char *>(m_buffer.data()), offsetOf(m_count));
+
+    if (!m_file) {
+      throw std::runtime_error("Failed to read run file: " + m_filename);
+    }
+
+    m_next += m_count;
+    m_pos = 0;
+    return true;
+  }
+
+  std::ifstream m_file;
+  std::string m_filename;
+  size_t m_next;
+  size_t m_end;
+  std::vector<int> m_buffer;
+  size_t m_pos = 0;
+  size_t m_count = 0;
+};
+
+/// @brief Сколько первых элементов x входит в первые rank элементов
+/// слияния x и y (merge path); из равных раньше идут элементы x.
+size_t splitPoint(std::span<const int> x, std::span<const int> y,
+                  size_t rank) {
+  size_t lo = rank > y.size() ? rank - y.size() : 0;
+  size_t hi = std::min(rank, x.size());
+
+  while (lo < hi) {
+    const size_t i = lo + (hi - lo) / 2;
+
+    if (x[i] <= y[rank - i - 1]) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+
+  return lo;
+}
+
+/// @brief Слияние двух диапазонов блоками через utils::simd::merge. Из
+/// блоков можно выдать всё, что не больше меньшего из их последних
+/// ключей: следующие блоки входов меньших элементов не содержат. Порция
+/// ограничена свободным местом в буфере выхода buffer (capacity
+/// элементов), и её граница в блоках находится splitPoint.
+template <typename Flush>
+void mergePair(RangeReader &a, RangeReader &b, std::vector<int> &buffer,
+               size_t capacity, const Flush &flush) {
+  while (true) {
+    std::span<const int> x = a.block();
+    std::span<const int> y = b.block();
+
+    if (x.empty() && y.empty()) {
+      return;
+    }
+
+    if (!x.empty() && !y.empty()) {
+      if (x.back() <= y.back()) {
+        y = y.first(std::upper_bound(y.begin(), y.end(), x.back()) -
+                    y.begin());
+      } else {
+        x = x.first(std::upper_bound(x.begin(), x.end(), y.back()) -
+                    x.begin());
+      }
+    }
+
+    const size_t rank = std::min(capacity - buffer.size(), x.size() + y.size());
+    const size_t fromX = splitPoint(x, y, rank);
+    const size_t fromY = rank - fromX;
+
+    const size_t offset = buffer.size();
+    buffer.resize(offset + rank);
+    utils::simd::merge(x.data(), fromX, y.data(), fromY,
+                       buffer.data() + offset);
+
+    a.consume(fromX);
+    b.consume(fromY);
+
+    if (buffer.size() == capacity) {
+      flush();
+    }
+  }
+}
+
+} // namespace
+
+ParallelMerger::ParallelMerger(std::vector<std::string> inputs,
+                               size_t threads, size_t bufferElements)
+    : m_inputs(std::move(inputs)), m_threads(threads),
+      m_bufferElements(bufferElements) {
+  if (threads == 0 || bufferElements == 0) {
+    throw std::invalid_argument("Threads and buffer size must be positive");
+  }
+}
+
+std::vector<size_t> ParallelMerger::coRank(const std::vector<SortedRun> &runs,
+                                           size_t rank) {
+  size_t total = 0;
+  for (const SortedRun &run : runs) {
+    total += run.size;
+  }
+
+  if (rank > total) {
+    throw std::invalid_argument("Rank exceeds total size");
+  }
+
+  // Число элементов серии, меньших value (или не больших, если inclusive).
+  const auto countBelow = [](const SortedRun &run, int64_t value,
+                             bool inclusive) {
+    size_t lo = 0;
+    size_t hi = run.size;
+
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      const int64_t x = run.at(mid);
+
+      if (x < value || (inclusive && x == value)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+
+    return lo;
+  };
+
+  std::vector<size_t> split(runs.size(), 0);
+
+  if (rank == 0) {
+    return split;
+  }
+
+  // Наименьшее значение, не больших которого во всех сериях хотя бы rank:
+  // все меньшие элементы входят в диапазон целиком, а равные ему
+  // добираются по порядку серий.
+  int64_t lo = std::numeric_limits<int>::min();
+  int64_t hi = std::numeric_limits<int>::max();
+
+  while (lo < hi) {
+    const int64_t mid = lo + (hi - lo) / 2;
+    size_t count = 0;
+
+    for (const SortedRun &run : runs) {
+      count += countBelow(run, mid, true);
+    }
+
+    if (count >= rank) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+
+  size_t remaining = rank;
+
+  for (size_t i = 0; i < runs.size(); ++i) {
+    split[i] = countBelow(runs[i], lo, false);
+    remaining -= split[i];
+  }
+
+  for (size_t i = 0; i < runs.size() && remaining > 0; ++i) {
+    const size_t equal = countBelow(runs[i], lo, true) - split[i];
+    const size_t take = std::min(remaining, equal);
+
+    split[i] += take;
+    remaining -= take;
+  }
+
+  return split;
+}
+
+size_t ParallelMerger::merge(const std::string &output, size_t limit) const {
+  std::vector<std::ifstream> files;
+  std::vector<SortedRun> runs;
+  size_t total = 0;
+
+  for (const std::string &input : m_inputs) {
+    files.emplace_back(input, std::ios::binary);
+
+    if (!files.back().is_open()) {
+      throw std::runtime_error("Failed to open run file: " + input);
+    }
+  }
+
+  for (size_t i = 0; i < m_inputs.size(); ++i) {
+    const size_t size = fs::file_size(m_inputs[i]) / sizeof(int);
+    total += size;
+
+    std::ifstream &file = files[i];
+    const std::string &name = m_inputs[i];
+
+    runs.push_back({size, [&file, &name](size_t index) {
+                      int value = 0;
+                      file.seekg(offsetOf(index));
+                      file.read(reinterpret_cast<char *>(&value), sizeof(int));
+
+                      if (!file) {
+                        throw std::runtime_error("Failed to read run file: " +
+                                                 name);
+                      }
+
+                      return value;
+                    }});
+  }
+
+  total = std::min(total, limit);
+
+  if (total == 0) {
+    return 0;
+  }
+
+  const size_t threads = std::min(m_threads, total);
+
+  // Границы диапазонов: поток p пишет элементы слияния с номерами
+  // [total * p / threads, total * (p + 1) / threads).
+  std::vector<std::vector<size_t>> bounds;
+  for (size_t p = 0; p <= threads; ++p) {
+    bounds.push_back(coRank(runs, total * p / threads));
+  }
+
+  if (fs::file_size(output) < total * sizeof(int)) {
+    fs::resize_file(output, total * sizeof(int));
+  }
+
+  std::vector<std::exception_ptr> errors(threads);
+  std::vector<std::thread> workers;
+
+  for (size_t p = 0; p < threads; ++p) {
+    workers.emplace_back([&, p] {
+      try {
+        mergeRange(bounds[p], bounds[p + 1], total * p / threads, output);
+      } catch (...) {
+        errors[p] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  return total;
+}
+
+void ParallelMerger::mergeRange(const std::vector<size_t> &begin,
+                                const std::vector<size_t> &end, size_t offset,
+                                const std::string &output) const {
+  std::vector<RangeReader> readers;
+  readers.reserve(m_inputs.size());
+
+  for (size_t i = 0; i < m_inputs.size(); ++i) {
+    readers.emplace_back(m_inputs[i], begin[i], end[i], m_bufferElements);
+  }
+
+  std::fstream out(output, std::ios::in | std::ios::out | std::ios::binary);
+
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to open output file: " + output);
+  }
+
+  out.seekp(offsetOf(offset));
+
+  std::vector<int> buffer;
+  buffer.reserve(m_bufferElements);
+
+  const auto flush = [&] {
+    out.write(reinterpret_cast<const char *>(buffer.data()),
+              offsetOf(buffer.size()));
+
+    if (!out) {
+      throw std::runtime_error("Failed to write output file: " + output);
+    }
+
+    buffer.clear();
+  };
+
+  // Два входа — обычный случай последнего попарного слияния — сливаются
+  // блоками векторным ядром, остальные — по одному элементу через кучу.
+  if (readers.size() == 2) {
+    mergePair(readers[0], readers[1], buffer, m_bufferElements, flush);
+    flush();
+    return;
+  }
+
+  using Head = std::pair<int, size_t>;
+  std::priority_queue<Head, std::vector<Head>, std::greater<>> heads;
+
+  for (size_t i = 0; i < readers.size(); ++i) {
+    int value = 0;
+    if (readers[i].next(value)) {
+      heads.emplace(value, i);
+    }
+  }
+
+  while (!heads.empty()) {
+    const auto [value, index] = heads.top();
+    heads.pop();
+
+    buffer.push_back(value);
+    if (buffer.size() == m_bufferElements) {
+      flush();
+    }
+
+    int next = 0;
+    if (readers[index].next(next)) {
+      heads.emplace(next, index);
+    }
+  }
+
+  flush();
+}
@@ -0,0 +1,230 @@
+#include "../../include/entities/SampleSorter.h"
+#include "../../include/entities/TapeSorter.h"
+#include "../../include/trace/TracingTape.h"
+#include "../../include/utils/utils.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+SampleSorter::SampleSorter(size_t memoryLimit, TapeConfig config,
+                           size_t partitions, std::string workDir)
+    : m_memoryLimit(memoryLimit), m_maxElements(memoryLimit / sizeof(int)),
+      m_partitions(std::max<size_t>(partitions, 1)), m_config(config),
+      m_workDir(std::move(workDir)) {}
+
+void SampleSorter::sort(TapeInterface &input, TapeInterface &output) {
+  std::vector<std::string> bucketFiles;
+
+  for (size_t i = 0; i < m_partitions; ++i) {
+    bucketFiles.push_back(m_workDir + "/sorted_" + std::to_string(i) + ".bin");
+  }
+
+  try {
+    auto sorted = run(input, bucketFiles, m_config.tempDirectIo,
+                      m_config.tempDurability);
+
+    output.rewind();
+
+    for (auto &bucket : sorted) {
+      bucket->rewind();
+      utils::copyTape(*bucket, output, bucket->getSize());
+    }
+
+    output.sync();
+
+    sorted.clear();
+    fs::remove_all(m_workDir);
+
+  } catch (const std::exception &e) {
+    fs::remove_all(m_workDir);
+    throw std::runtime_error("[SAMPLE]" + std::string(e.what()));
+  }
+}
+
+std::vector<std::string>
+SampleSorter::sortToPartitions(TapeInterface &input,
+                               const std::string &outputPrefix) {
+  std::vector<std::string> outputFiles;
+
+  for (size_t i = 0; i < m_partitions; ++i) {
+    outputFiles.push_back(outputPrefix + "_" + std::to_string(i) + ".bin");
+  }
+
+  try {
+    for (const auto &file : outputFiles) {
+      fs::remove(file);
+    }
+
+    run(input, outputFiles, m_config.outputDirectIo,
+        m_config.outputDurability);
+    fs::remove_all(m_workDir);
+
+  } catch (const std::exception &e) {
+    fs::remove_all(m_workDir);
+    throw std::runtime_error("[SAMPLE]" + std::string(e.what()));
+  }
+
+  return outputFiles;
+}
+
+void SampleSorter::setMergeStrategy(MergeStrategy strategy) {
+  m_strategy = strategy;
+}
+
+void SampleSorter::setTraceRecorder(TraceRecorder *recorder) {
+  m_traceRecorder = recorder;
+}
+
+const SortStats &SampleSorter::getStats() const { return m_stats; }
+
+std::unique_ptr<TapeInterface>
+SampleSorter::traced(std::unique_ptr<TapeInterface> tape) const {
+  if (m_traceRecorder == nullptr) {
+    return tape;
+  }
+
+  return std::make_unique<TracingTape>(std::move(tape), *m_traceRecorder);
+}
+
+std::vector<std::unique_ptr<TapeInterface>>
+SampleSorter::run(TapeInterface &input,
+                  const std::vector<std::string> &outputFiles, bool directIo,
+                  Durability durability) {
+  m_stats = SortStats();
+
+  if (!fs::create_directories(m_workDir) && !fs::exists(m_workDir)) {
+    throw std::runtime_error("Failed to create directory: " + m_workDir);
+  }
+
+  const std::vector<int> splitters = chooseSplitters(input);
+  auto buckets = partition(input, splitters);
+
+  return sortBuckets(buckets, outputFiles, directIo, durability);
+}
+
+std::vector<int> SampleSorter::chooseSplitters(TapeInterface &input) const {
+  const size_t size = input.getSize();
+  const size_t sampleSize = std::max<size_t>(
+      std::min({m_partitions * kOversampling, m_maxElements, size}), 1);
+  const size_t stride = std::max<size_t>(size / sampleSize, 1);
+
+  std::vector<int> sample;
+  input.rewind();
+
+  for (size_t i = 0; !input.isAtEnd() && sample.size() < sampleSize; ++i) {
+    if (i % stride == 0) {
+      sample.push_back(input.read());
+    }
+
+    input.moveRight();
+  }
+
+  std::vector<int> splitters;
+
+  if (sample.empty()) {
+    return splitters;
+  }
+
+  std::sort(sample.begin(), sample.end());
+
+  for (size_t i = 1; i < m_partitions; ++i) {
+    splitters.push_back(sample[i * sample.size() / m_partitions]);
+  }
+
+  return splitters;
+}
+
+std::vector<std::unique_ptr<TapeInterface>>
+SampleSorter::partition(TapeInterface &input,
+                        const std::vector<int> &splitters) const {
+  const size_t maxBytes = input.getSize() * sizeof(int);
+
+  std::vector<std::unique_ptr<TapeInterface>> buckets;
+
+  for (size_t i = 0; i < m_partitions; ++i) {
+    const std::string filename =
+        m_workDir + "/bucket_" + std::to_string(i) + ".bin";
+
+    buckets.push_back(traced(utils::createFileTape(
+        maxBytes, m_config, filename, m_config.tempDirectIo,
+        m_config.tempDurability)));
+  }
+
+  input.rewind();
+
+  while (!input.isAtEnd()) {
+    int x = input.read();
+
+    // Равные ключи попадают в одну корзину, поэтому корзины не пересекаются.
+    size_t index = std::upper_bound(splitters.begin(), splitters.end(), x) -
+                   splitters.begin();
+
+    buckets[index]->write(x);
+    buckets[index]->moveRight();
+    input.moveRight();
+  }
+
+  for (auto &bucket : buckets) {
+    bucket->sync();
+  }
+
+  return buckets;
+}
+
+std::vector<std::unique_ptr<TapeInterface>> SampleSorter::sortBuckets(
+    std::vector<std::unique_ptr<TapeInterface>> &buckets,
+    const std::vector<std::string> &outputFiles, bool directIo,
+    Durability durability) {
+  const size_t memoryPerBucket =
+      std::max(m_memoryLimit / m_partitions, sizeof(int));
+
+  std::vector<std::unique_ptr<TapeInterface>> sorted(buckets.size());
+  std::vector<SortStats> stats(buckets.size());
+  std::vector<std::exception_ptr> errors(buckets.size());
+  std::vector<std::thread> workers;
+
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    workers.emplace_back([&, i] {
+      try {
+        const size_t bytes = buckets[i]->getSize() * sizeof(int);
+        sorted[i] = traced(utils::createFileTape(
+            bytes, m_config, outputFiles[i], directIo, durability));
+
+        TapeSorter sorter(memoryPerBucket, m_config,
+                          m_workDir + "/tmp_" + std::to_string(i));
+        sorter.setMergeStrategy(m_strategy);
+        sorter.setTraceRecorder(m_traceRecorder);
+        sorter.sort(*buckets[i], *sorted[i]);
+        stats[i] = sorter.getStats();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  for (const SortStats &bucket : stats) {
+    m_stats.runs += bucket.runs;
+    m_stats.mergePasses += bucket.mergePasses;
+    m_stats.rewinds += bucket.rewinds;
+    m_stats.mergedElements += bucket.mergedElements;
+    m_stats.countingSort = m_stats.countingSort || bucket.countingSort;
+  }
+
+  return sorted;
+}
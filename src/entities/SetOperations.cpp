@@ -0,0 +1,237 @@
+#include "../../include/entities/SetOperations.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// @brief Последовательное чтение отсортированной ленты блоками.
+class Cursor {
+public:
+  Cursor(TapeInterface &tape, size_t blockElements, bool gallop,
+         SetOperationStats &stats)
+      : m_tape(tape), m_remaining(tape.getSize()), m_gallop(gallop),
+        m_stats(stats) {
+    m_block.resize(blockElements);
+
+    m_tape.rewind();
+    load();
+  }
+
+  bool done() const { return m_pos == m_count; }
+
+  int head() const { return m_block[m_pos]; }
+
+  /// @brief Пропускает элементы меньше key (или не больше, если
+  /// inclusive), записывая их в out, если он задан. Возвращает число
+  /// пропущенных элементов.
+  size_t advance(int key, bool inclusive, TapeInterface *out) {
+    size_t skipped = 0;
+
+    while (!done()) {
+      const size_t end = findEnd(key, inclusive);
+
+      if (out != nullptr) {
+        for (size_t i = m_pos; i < end; ++i) {
+          out->write(m_block[i]);
+          out->moveRight();
+        }
+
+        m_stats.written += end - m_pos;
+      }
+
+      skipped += end - m_pos;
+      m_pos = end;
+
+      if (m_pos < m_count) {
+        break;
+      }
+
+      load();
+    }
+
+    return skipped;
+  }
+
+  /// @brief Дописывает остаток ленты в out.
+  void drain(TapeInterface &out) {
+    while (!done()) {
+      for (; m_pos < m_count; ++m_pos) {
+        out.write(m_block[m_pos]);
+        out.moveRight();
+        ++m_stats.written;
+      }
+
+      load();
+    }
+  }
+
+private:
+  TapeInterface &m_tape;
+  size_t m_remaining;
+  bool m_gallop;
+  SetOperationStats &m_stats;
+
+  std::vector<int> m_block;
+  size_t m_pos = 0;
+  size_t m_count = 0;
+
+  void load() {
+    m_count = std::min(m_block.size(), m_remaining);
+    m_pos = 0;
+
+    for (size_t i = 0; i < m_count; ++i) {
+      m_block[i] = m_tape.read();
+      m_tape.moveRight();
+    }
+
+    m_remaining -= m_count;
+  }
+
+  /// @brief Первая позиция блока начиная с m_pos, где элемент не меньше
+  /// key (больше key, если inclusive); m_count, если таких нет.
+  size_t findEnd(int key, bool inclusive) {
+    const auto below = [&](size_t i) {
+      ++m_stats.comparisons;
+      return inclusive ? m_block[i] <= key : m_block[i] < key;
+    };
+
+    if (!m_gallop) {
+      size_t i = m_pos;
+      while (i < m_count && below(i)) {
+        ++i;
+      }
+
+      return i;
+    }
+
+    // Экспоненциальный поиск: шаги 1, 2, 4, ... находят отрезок, где
+    // кончаются меньшие элементы, затем бинарный поиск внутри него.
+    size_t lo = m_pos;
+    size_t step = 1;
+
+    while (m_pos + step - 1 < m_count && below(m_pos + step - 1)) {
+      lo = m_pos + step;
+      step *= 2;
+    }
+
+    size_t hi = std::min(m_pos + step - 1, m_count);
+
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+
+      if (below(mid)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+
+    return lo;
+  }
+};
+
+/// @brief Общий проход двух лент. Ключи, которых нет в другой ленте,
+/// пишутся в leftOut и rightOut (или пропускаются, если nullptr); для
+/// общих ключей вызывается onMatch(key, leftCount, rightCount).
+template <typename OnMatch>
+void walk(Cursor &left, Cursor &right, TapeInterface *leftOut,
+          TapeInterface *rightOut, OnMatch onMatch) {
+  while (!left.done() && !right.done()) {
+    const int x = left.head();
+    const int y = right.head();
+
+    if (x < y) {
+      left.advance(y, false, leftOut);
+    } else if (y < x) {
+      right.advance(x, false, rightOut);
+    } else {
+      const size_t leftCount = left.advance(x, true, nullptr);
+      const size_t rightCount = right.advance(x, true, nullptr);
+      onMatch(x, leftCount, rightCount);
+    }
+  }
+
+  if (leftOut != nullptr) {
+    left.drain(*leftOut);
+  }
+
+  if (rightOut != nullptr) {
+    right.drain(*rightOut);
+  }
+}
+
+} // namespace
+
+SetOperations::SetOperations(size_t memoryLimit, bool gallop)
+    : m_blockElements(std::max<size_t>(1, memoryLimit / sizeof(int) / 2)),
+      m_gallop(gallop) {}
+
+size_t SetOperations::apply(SetOperation operation, TapeInterface &left,
+                            TapeInterface &right, TapeInterface &output) {
+  m_stats = SetOperationStats{};
+
+  Cursor leftCursor(left, m_blockElements, m_gallop, m_stats);
+  Cursor rightCursor(right, m_blockElements, m_gallop, m_stats);
+
+  output.rewind();
+
+  // Ключи только одной ленты остаются в объединении и слиянии, а в
+  // разности — только ключи левой.
+  TapeInterface *leftOut =
+      operation == SetOperation::Intersection ? nullptr : &output;
+  TapeInterface *rightOut = operation == SetOperation::Union ||
+                                    operation == SetOperation::Merge
+                                ? &output
+                                : nullptr;
+
+  walk(leftCursor, rightCursor, leftOut, rightOut,
+       [&](int key, size_t a, size_t b) {
+         size_t copies = 0;
+
+         switch (operation) {
+         case SetOperation::Union:
+           copies = std::max(a, b);
+           break;
+         case SetOperation::Intersection:
+           copies = std::min(a, b);
+           break;
+         case SetOperation::Difference:
+           copies = a > b ? a - b : 0;
+           break;
+         case SetOperation::Merge:
+           copies = a + b;
+           break;
+         }
+
+         for (size_t i = 0; i < copies; ++i) {
+           output.write(key);
+           output.moveRight();
+         }
+
+         m_stats.written += copies;
+       });
+
+  output.sync();
+  return m_stats.written;
+}
+
+size_t SetOperations::join(TapeInterface &left, TapeInterface &right,
+                           const JoinVisitor &visit) {
+  m_stats = SetOperationStats{};
+
+  Cursor leftCursor(left, m_blockElements, m_gallop, m_stats);
+  Cursor rightCursor(right, m_blockElements, m_gallop, m_stats);
+
+  size_t keys = 0;
+
+  walk(leftCursor, rightCursor, nullptr, nullptr,
+       [&](int key, size_t a, size_t b) {
+         visit(key, a, b);
+         ++keys;
+       });
+
+  return keys;
+}
+
+const SetOperationStats &SetOperations::getStats() const { return m_stats; }
@@ -0,0 +1,121 @@
+#include "../../include/entities/SortVerification.h"
+
+#include <stdexcept>
+
+namespace {
+
+/// @brief Финализатор splitmix64: соседние значения дают независимые на
+/// вид хеши, поэтому ошибки вида «x + 1 вместо x» не компенсируют друг
+/// друга в сумме.
+uint64_t mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+} // namespace
+
+void Checksum::add(int value, size_t times) {
+  count += times;
+  sum += mix(static_cast<uint32_t>(value)) * static_cast<uint64_t>(times);
+}
+
+namespace {
+
+Checksum checksumOf(TapeInterface &tape) {
+  Checksum checksum;
+
+  tape.rewind();
+
+  while (!tape.isAtEnd()) {
+    checksum.add(tape.read());
+    tape.moveRight();
+  }
+
+  return checksum;
+}
+
+} // namespace
+
+VerifyingTape::VerifyingTape(TapeInterface &tape, OrderLess less)
+    : m_tape(tape), m_less(less) {}
+
+int VerifyingTape::read() { return m_tape.read(); }
+
+void VerifyingTape::write(int data) {
+  if (m_position != m_checksum.count) {
+    throw std::logic_error("Verified output is not written sequentially");
+  }
+
+  m_tape.write(data);
+
+  if (m_checksum.count > 0 && m_less(data, m_last) && m_sorted) {
+    m_sorted = false;
+    m_firstUnsorted = m_position;
+  }
+
+  m_checksum.add(data);
+  m_last = data;
+}
+
+void VerifyingTape::moveLeft() {
+  m_tape.moveLeft();
+
+  if (m_position > 0) {
+    --m_position;
+  }
+}
+
+void VerifyingTape::moveRight() {
+  m_tape.moveRight();
+  ++m_position;
+}
+
+void VerifyingTape::rewind() {
+  m_tape.rewind();
+  m_position = 0;
+
+  m_checksum = Checksum{};
+  m_sorted = true;
+  m_firstUnsorted = 0;
+}
+
+bool VerifyingTape::isAtEnd() const { return m_tape.isAtEnd(); }
+
+size_t VerifyingTape::getSize() const { return m_tape.getSize(); }
+
+void VerifyingTape::sync() { m_tape.sync(); }
+
+void VerifyingTape::report(SortVerification &result) const {
+  result.output = m_checksum;
+  result.sorted = m_sorted;
+  result.firstUnsorted = m_firstUnsorted;
+}
+
+SortVerification verifySorted(TapeInterface &output, TapeInterface *input,
+                              OrderLess less) {
+  SortVerification result;
+  int last = 0;
+
+  output.rewind();
+
+  while (!output.isAtEnd()) {
+    const int value = output.read();
+
+    if (result.output.count > 0 && less(value, last) && result.sorted) {
+      result.sorted = false;
+      result.firstUnsorted = result.output.count;
+    }
+
+    result.output.add(value);
+    last = value;
+
+    output.moveRight();
+  }
+
+  // Без входа сравнивать не с чем: проверяется только порядок.
+  result.input = input != nullptr ? checksumOf(*input) : result.output;
+
+  return result;
+}
@@ -0,0 +1,44 @@
+#include "../../include/entities/StreamSorter.h"
+#include "../../include/entities/streamTapes/CallbackTape.h"
+#include "../../include/entities/streamTapes/GeneratorTape.h"
+
+#include <stdexcept>
+#include <utility>
+
+StreamSorter::StreamSorter(size_t memoryLimit, TapeConfig config,
+                           std::string tmpDir)
+    : m_sorter(memoryLimit, std::move(config), std::move(tmpDir)) {
+  if (memoryLimit < sizeof(int)) {
+    throw std::invalid_argument("memoryLimit must hold at least one element");
+  }
+}
+
+void StreamSorter::sort(const Generator &source, const Sink &sink) {
+  GeneratorTape input(source);
+  CallbackTape output(sink);
+
+  // Попарное слияние читает вход только вперёд и пишет выход только
+  // дозаписью, поэтому подходит для потоковых лент.
+  m_sorter.setMergeStrategy(MergeStrategy::Pairwise);
+  m_sorter.sort(input, output);
+}
+
+void StreamSorter::sort(std::istream &input, const Sink &sink) {
+  sort(
+      [&input]() -> std::optional<int> {
+        int value = 0;
+
+        if (input >> value) {
+          return value;
+        }
+
+        if (!input.eof()) {
+          throw std::runtime_error("Invalid integer in input stream");
+        }
+
+        return std::nullopt;
+      },
+      sink);
+}
+
+const SortStats &StreamSorter::getStats() const { return m_sorter.getStats(); }
@@ -1,13 +1,164 @@
 #include "../../../include/entities/fileTapes/BinaryFileTape.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstdint>
 #include <stdexcept>
+#include <system_error>
 #include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// @brief Фиксирует содержимое файла на диске. На Windows fsync нет, и
+/// режим Fsync сводится к сбросу буфера.
+void syncFile(const std::string &filename) {
+#ifndef _WIN32
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "Failed to open " + filename);
+  }
+
+  const int result = ::fsync(fd);
+  const int error = errno;
+  ::close(fd);
+
+  if (result != 0) {
+    throw std::system_error(error, std::generic_category(),
+                            "Failed to fsync " + filename);
+  }
+#else
+  (void)filename;
+#endif
+}
+
+#ifdef __linux__
+
+/// @brief Дескриптор, закрываемый при выходе из области видимости.
+class Descriptor {
+public:
+  Descriptor(const std::string &filename, int flags)
+      : m_fd(::open(filename.c_str(), flags)) {}
+
+  ~Descriptor() {
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+  }
+
+  Descriptor(const Descriptor &) = delete;
+  Descriptor &operator=(const Descriptor &) = delete;
+
+  int get() const { return m_fd; }
+
+private:
+  int m_fd;
+};
+
+bool isUnsupported(int error) {
+  return error == EXDEV || error == ENOSYS || error == EINVAL ||
+         error == EOPNOTSUPP || error == EBADF;
+}
+
+/// @brief Копирует bytes байт из файла from (со смещения fromOffset) в файл
+/// to (со смещения toOffset) средствами ядра. Возвращает false, если ни
+/// один способ не поддерживается и ничего не скопировано.
+bool kernelCopy(const std::string &from, off_t fromOffset,
+                const std::string &to, off_t toOffset, size_t bytes) {
+  const Descriptor in(from, O_RDONLY);
+  const Descriptor out(to, O_WRONLY);
+
+  if (in.get() < 0 || out.get() < 0) {
+    return false;
+  }
+
+  // Файл целиком в пустой файл: reflink делит блоки без копирования.
+  struct stat source {};
+  struct stat target {};
+  if (fromOffset == 0 && toOffset == 0 && ::fstat(in.get(), &source) == 0 &&
+      ::fstat(out.get(), &target) == 0 &&
+      static_cast<size_t>(source.st_size) == bytes &&
+      static_cast<size_t>(target.st_size) <= bytes &&
+      ::ioctl(out.get(), FICLONE, in.get()) == 0) {
+    return true;
+  }
+
+  size_t copied = 0;
+  bool useSendfile = false;
+
+  while (copied < bytes) {
+    ssize_t n = -1;
+
+    if (!useSendfile) {
+      n = ::copy_file_range(in.get(), &fromOffset, out.get(), &toOffset,
+                            bytes - copied, 0);
+
+      if (n < 0 && copied == 0 && isUnsupported(errno)) {
+        useSendfile = true;
+        continue;
+      }
+    } else {
+      // sendfile пишет с текущей позиции выходного файла.
+      if (copied == 0 && ::lseek(out.get(), toOffset, SEEK_SET) < 0) {
+        return false;
+      }
+
+      n = ::sendfile(out.get(), in.get(), &fromOffset, bytes - copied);
+
+      if (n < 0 && copied == 0 && isUnsupported(errno)) {
+        return false;
+      }
+    }
+
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if (n <= 0) {
+      throw std::system_error(n < 0 ? errno : EIO, std::generic_category(),
+                              "Failed to copy " + from + " to " + to);
+    }
+
+    copied += static_cast<size_t>(n);
+  }
+
+  return true;
+}
+
+#else
+
+bool kernelCopy(const std::string &, int64_t, const std::string &, int64_t,
+                size_t) {
+  return false;
+}
+
+#endif
+
+} // namespace
 
 BinaryFileTape::BinaryFileTape(const std::string &filename,
-                               const size_t sizeTape, const TapeConfig &config)
-    : m_currentPosition(0), m_size(0), m_maxSize(sizeTape / sizeof(int)),
-      m_filename(filename), m_config(config) {
+                               const size_t sizeTape, const TapeConfig &config,
+                               Durability durability)
+    : m_currentPosition(0), m_size(0), m_streamPosition(0),
+      m_streamMode(StreamMode::None), m_maxSize(sizeTape / sizeof(int)),
+      m_filename(filename), m_config(config), m_durability(durability) {
 
   m_file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
 
@@ -33,9 +184,12 @@ BinaryFileTape::~BinaryFileTape() noexcept {
 
 BinaryFileTape::BinaryFileTape(BinaryFileTape &&other) noexcept
     : m_currentPosition(other.m_currentPosition), m_size(other.m_size),
-      m_maxSize(other.m_maxSize), m_file(std::move(other.m_file)),
+      m_streamPosition(other.m_streamPosition),
+      m_streamMode(other.m_streamMode), m_maxSize(other.m_maxSize),
+      m_file(std::move(other.m_file)),
       m_filename(std::move(other.m_filename)),
-      m_config(std::move(other.m_config)) {
+      m_config(std::move(other.m_config)),
+      m_durability(other.m_durability) {
   other.m_currentPosition = 0;
   other.m_size = 0;
   other.m_maxSize = 0;
@@ -47,10 +201,13 @@ BinaryFileTape &BinaryFileTape::operator=(BinaryFileTape &&other) noexcept {
       m_file.close();
     m_currentPosition = other.m_currentPosition;
     m_size = other.m_size;
+    m_streamPosition = other.m_streamPosition;
+    m_streamMode = other.m_streamMode;
     m_maxSize = other.m_maxSize;
     m_file = std::move(other.m_file);
     m_filename = std::move(other.m_filename);
     m_config = std::move(other.m_config);
+    m_durability = other.m_durability;
 
     other.m_currentPosition = 0;
     other.m_size = 0;
@@ -62,10 +219,21 @@ BinaryFileTape &BinaryFileTape::operator=(BinaryFileTape &&other) noexcept {
 void BinaryFileTape::updateSize() {
   m_file.seekg(0, std::ios::end);
 
-  int bytes = m_file.tellg();
-  m_size = bytes / sizeof(int);
+  const std::streamoff bytes = m_file.tellg();
+  m_size = bytes > 0 ? static_cast<size_t>(bytes) / sizeof(int) : 0;
 
-  m_file.seekg(m_currentPosition * sizeof(int));
+  m_streamMode = StreamMode::None;
+}
+
+void BinaryFileTape::seekTo(StreamMode mode) {
+  // filebuf требует позиционирования при смене чтения на запись и обратно.
+  if (m_streamPosition != m_currentPosition || m_streamMode != mode) {
+    m_file.seekg(static_cast<std::streamoff>(m_currentPosition) *
+                 static_cast<std::streamoff>(sizeof(int)));
+    m_streamPosition = m_currentPosition;
+  }
+
+  m_streamMode = mode;
 }
 
 int BinaryFileTape::read() {
@@ -74,11 +242,19 @@ int BinaryFileTape::read() {
 
   applyDelay(m_config.readDelay);
 
-  m_file.seekg(m_currentPosition * sizeof(int));
+  seekTo(StreamMode::Read);
 
   int value;
   m_file.read(reinterpret_cast<char *>(&value), sizeof(int));
 
+  if (!m_file) {
+    m_file.clear();
+    m_streamMode = StreamMode::None;
+    throw std::runtime_error("Failed to read from file: " + m_filename);
+  }
+
+  ++m_streamPosition;
+
   return value;
 }
 
@@ -93,13 +269,14 @@ void BinaryFileTape::write(int data) {
     throw std::out_of_range("Write position out of range");
   }
 
-  m_file.seekp(m_currentPosition * sizeof(int));
+  seekTo(StreamMode::Write);
+
   m_file.write(reinterpret_cast<char *>(&data), sizeof(int));
-  m_file.flush();
+
+  ++m_streamPosition;
 
   if (m_currentPosition == m_size) {
     m_size++;
-    updateSize();
   }
 }
 
@@ -109,7 +286,6 @@ void BinaryFileTape::moveLeft() {
     applyDelay(m_config.shiftDelay);
 
     m_currentPosition--;
-    m_file.seekg(m_currentPosition * sizeof(int));
   }
 }
 
@@ -118,7 +294,6 @@ void BinaryFileTape::moveRight() {
     applyDelay(m_config.shiftDelay);
 
     m_currentPosition++;
-    m_file.seekg(m_currentPosition * sizeof(int));
   }
 }
 
@@ -126,17 +301,120 @@ void BinaryFileTape::rewind() {
   applyDelay(m_config.rewindDelay);
 
   m_currentPosition = 0;
-  m_file.seekg(0);
 }
 
 bool BinaryFileTape::isAtEnd() const { return m_currentPosition >= m_size; }
 
 size_t BinaryFileTape::getSize() const { return m_size; }
 
+void BinaryFileTape::sync() {
+  if (m_durability == Durability::None) {
+    return;
+  }
+
+  flush();
+
+  if (m_durability == Durability::Fsync) {
+    syncFile(m_filename);
+  }
+}
+
+void BinaryFileTape::flush() {
+  m_file.flush();
+
+  if (!m_file) {
+    m_file.clear();
+    m_streamMode = StreamMode::None;
+    throw std::runtime_error("Failed to flush file: " + m_filename);
+  }
+}
+
 size_t BinaryFileTape::getMaxSize() const { return m_maxSize; }
 
 std::string BinaryFileTape::getFilename() const { return m_filename; }
 
+const TapeConfig &BinaryFileTape::getConfig() const { return m_config; }
+
+void BinaryFileTape::reload() {
+  updateSize();
+
+  if (m_size > m_maxSize) {
+    throw std::runtime_error("File size exceeds maximum allowed size");
+  }
+}
+
+void BinaryFileTape::copyFrom(BinaryFileTape &source, size_t count) {
+  if (count == 0) {
+    return;
+  }
+
+  if (source.m_currentPosition + count > source.m_size) {
+    throw std::out_of_range("Read position out of range");
+  }
+
+  if (m_currentPosition > m_size) {
+    throw std::out_of_range("Write position out of range");
+  }
+
+  if (m_currentPosition + count > m_maxSize) {
+    throw std::out_of_range("Write position exceeds maximum size");
+  }
+
+  source.applyDelay(source.m_config.readDelay + source.m_config.shiftDelay,
+                    count);
+  applyDelay(m_config.writeDelay + m_config.shiftDelay, count);
+
+  // Данные идут мимо буферов fstream: записанное должно быть в файле, а
+  // прочитанное заранее — сброшено следующим позиционированием.
+  source.m_file.flush();
+  m_file.flush();
+  source.m_streamMode = StreamMode::None;
+  m_streamMode = StreamMode::None;
+
+  const auto offsetOf = [](size_t position) {
+    return static_cast<std::streamoff>(position) *
+           static_cast<std::streamoff>(sizeof(int));
+  };
+
+  if (!kernelCopy(source.m_filename, offsetOf(source.m_currentPosition),
+                  m_filename, offsetOf(m_currentPosition),
+                  count * sizeof(int))) {
+    std::vector<int> buffer(std::min<size_t>(count, 64 * 1024));
+
+    source.m_file.seekg(offsetOf(source.m_currentPosition));
+    m_file.seekp(offsetOf(m_currentPosition));
+
+    for (size_t done = 0; done < count;) {
+      const size_t chunk = std::min(buffer.size(), count - done);
+
+      source.m_file.read(reinterpret_cast<char *>(buffer.data()),
+                         offsetOf(chunk));
+      m_file.write(reinterpret_cast<const char *>(buffer.data()),
+                   offsetOf(chunk));
+
+      if (!source.m_file || !m_file) {
+        source.m_file.clear();
+        m_file.clear();
+        throw std::runtime_error("Failed to copy " + source.m_filename +
+                                 " to " + m_filename);
+      }
+
+      done += chunk;
+    }
+
+    m_file.flush();
+  }
+
+  source.m_currentPosition += count;
+  m_currentPosition += count;
+  m_size = std::max(m_size, m_currentPosition);
+}
+
 void BinaryFileTape::applyDelay(int delay) const {
   std::this_thread::sleep_for(std::chrono::milliseconds(delay));
 }
+
+void BinaryFileTape::applyDelay(int delay, size_t count) const {
+  std::this_thread::sleep_for(std::chrono::milliseconds(
+      static_cast<int64_t>(delay) * static_cast<int64_t>(count)));
+}
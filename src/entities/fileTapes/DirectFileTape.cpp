@@ -0,0 +1,340 @@
+#include "../../../include/entities/fileTapes/DirectFileTape.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#ifndef _WIN32
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t kAlignment = 4096;
+constexpr size_t kBlockBytes = 64 * 1024;
+constexpr size_t kBlockElements = kBlockBytes / sizeof(int);
+constexpr size_t kNoBlock = static_cast<size_t>(-1);
+
+/// @brief Пул выровненных блоков: временные ленты создаются и удаляются на
+/// каждом уровне слияния, и пул избавляет их от повторных выделений.
+class AlignedBufferPool {
+public:
+  static AlignedBufferPool &instance() {
+    static AlignedBufferPool pool;
+    return pool;
+  }
+
+  int *acquire() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      if (!m_free.empty()) {
+        int *block = m_free.back();
+        m_free.pop_back();
+        return block;
+      }
+    }
+
+    void *memory = std::aligned_alloc(kAlignment, kBlockBytes);
+
+    if (memory == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    return static_cast<int *>(memory);
+  }
+
+  void release(int *block) noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_free.size() < kMaxCached) {
+      m_free.push_back(block);
+    } else {
+      std::free(block);
+    }
+  }
+
+  ~AlignedBufferPool() {
+    for (int *block : m_free) {
+      std::free(block);
+    }
+  }
+
+private:
+  static constexpr size_t kMaxCached = 64;
+
+  std::mutex m_mutex;
+  std::vector<int *> m_free;
+};
+
+int openFile(const std::string &filename, bool direct) {
+  int flags = O_RDWR | O_CREAT;
+
+#ifdef O_DIRECT
+  if (direct) {
+    flags |= O_DIRECT;
+  }
+#else
+  (void)direct;
+#endif
+
+  return ::open(filename.c_str(), flags, 0644);
+}
+
+} // namespace
+
+DirectFileTape::DirectFileTape(const std::string &filename,
+                               const size_t sizeTape, const TapeConfig &config,
+                               Durability durability)
+    : m_currentPosition(0), m_size(0), m_maxSize(sizeTape / sizeof(int)),
+      m_fd(-1), m_direct(false), m_block(nullptr), m_blockIndex(kNoBlock),
+      m_dirty(false), m_filename(filename), m_config(config),
+      m_durability(durability) {
+
+#ifdef O_DIRECT
+  m_fd = openFile(filename, true);
+  m_direct = m_fd >= 0;
+#endif
+
+  if (m_fd < 0) {
+    m_fd = openFile(filename, false);
+  }
+
+  if (m_fd < 0) {
+    throw std::runtime_error("Failed to open file: " + filename + ": " +
+                             std::strerror(errno));
+  }
+
+  struct stat info {};
+
+  if (::fstat(m_fd, &info) != 0) {
+    ::close(m_fd);
+    throw std::runtime_error("Failed to stat file: " + filename);
+  }
+
+  m_size = static_cast<size_t>(info.st_size) / sizeof(int);
+
+  if (m_size > m_maxSize) {
+    ::close(m_fd);
+    throw std::runtime_error("File size exceeds maximum allowed size");
+  }
+
+  m_block = AlignedBufferPool::instance().acquire();
+}
+
+DirectFileTape::~DirectFileTape() noexcept {
+  try {
+    flushBlock();
+  } catch (...) {
+  }
+
+  // Блоки пишутся целиком, поэтому хвост последнего блока обрезается.
+  [[maybe_unused]] const int truncated =
+      ::ftruncate(m_fd, static_cast<off_t>(m_size * sizeof(int)));
+
+  ::close(m_fd);
+  AlignedBufferPool::instance().release(m_block);
+}
+
+int DirectFileTape::read() {
+  if (m_currentPosition >= m_size)
+    throw std::out_of_range("Read position out of range");
+
+  applyDelay(m_config.readDelay);
+
+  loadBlock(m_currentPosition / kBlockElements);
+
+  return m_block[m_currentPosition % kBlockElements];
+}
+
+void DirectFileTape::write(int data) {
+  applyDelay(m_config.writeDelay);
+
+  if (m_currentPosition >= m_maxSize) {
+    throw std::out_of_range("Write position exceeds maximum size");
+  }
+
+  if (m_currentPosition > m_size) {
+    throw std::out_of_range("Write position out of range");
+  }
+
+  loadBlock(m_currentPosition / kBlockElements);
+
+  m_block[m_currentPosition % kBlockElements] = data;
+  m_dirty = true;
+
+  if (m_currentPosition == m_size) {
+    m_size++;
+  }
+}
+
+void DirectFileTape::moveLeft() {
+  if (m_currentPosition > 0) {
+    applyDelay(m_config.shiftDelay);
+
+    m_currentPosition--;
+  }
+}
+
+void DirectFileTape::moveRight() {
+  if (m_currentPosition < m_maxSize || m_currentPosition > m_size) {
+    applyDelay(m_config.shiftDelay);
+
+    m_currentPosition++;
+  }
+}
+
+void DirectFileTape::rewind() {
+  applyDelay(m_config.rewindDelay);
+
+  m_currentPosition = 0;
+}
+
+bool DirectFileTape::isAtEnd() const { return m_currentPosition >= m_size; }
+
+size_t DirectFileTape::getSize() const { return m_size; }
+
+void DirectFileTape::sync() {
+  if (m_durability == Durability::None) {
+    return;
+  }
+
+  flushBlock();
+
+  if (::ftruncate(m_fd, static_cast<off_t>(m_size * sizeof(int))) != 0) {
+    throw std::runtime_error("Failed to truncate " + m_filename);
+  }
+
+  if (m_durability == Durability::Fsync && ::fsync(m_fd) != 0) {
+    throw std::runtime_error("Failed to fsync " + m_filename);
+  }
+}
+
+size_t DirectFileTape::getMaxSize() const { return m_maxSize; }
+
+std::string DirectFileTape::getFilename() const { return m_filename; }
+
+bool DirectFileTape::isDirect() const { return m_direct; }
+
+bool DirectFileTape::isSupported() {
+#ifdef O_DIRECT
+  return true;
+#else
+  // Без O_DIRECT openFile всегда открывает файл через кэш страниц.
+  return false;
+#endif
+}
+
+void DirectFileTape::loadBlock(size_t index) {
+  if (index == m_blockIndex) {
+    return;
+  }
+
+  flushBlock();
+
+  const size_t offset = index * kBlockBytes;
+  size_t loaded = 0;
+
+  // Блок целиком за концом данных читать незачем.
+  if (offset < m_size * sizeof(int)) {
+    ssize_t bytes = ::pread(m_fd, m_block, kBlockBytes, offset);
+
+    if (bytes < 0 && errno == EINVAL && m_direct) {
+      disableDirect();
+      bytes = ::pread(m_fd, m_block, kBlockBytes, offset);
+    }
+
+    if (bytes < 0) {
+      throw std::runtime_error("Failed to read block from " + m_filename +
+                               ": " + std::strerror(errno));
+    }
+
+    loaded = static_cast<size_t>(bytes);
+  }
+
+  std::memset(reinterpret_cast<char *>(m_block) + loaded, 0,
+              kBlockBytes - loaded);
+
+  m_blockIndex = index;
+}
+
+void DirectFileTape::flushBlock() {
+  if (!m_dirty) {
+    return;
+  }
+
+  const size_t offset = m_blockIndex * kBlockBytes;
+
+  ssize_t bytes = ::pwrite(m_fd, m_block, kBlockBytes, offset);
+
+  if (bytes < 0 && errno == EINVAL && m_direct) {
+    disableDirect();
+    bytes = ::pwrite(m_fd, m_block, kBlockBytes, offset);
+  }
+
+  if (bytes != static_cast<ssize_t>(kBlockBytes)) {
+    throw std::runtime_error("Failed to write block to " + m_filename);
+  }
+
+  m_dirty = false;
+}
+
+void DirectFileTape::disableDirect() {
+#ifdef O_DIRECT
+  const int flags = ::fcntl(m_fd, F_GETFL);
+  ::fcntl(m_fd, F_SETFL, flags & ~O_DIRECT);
+#endif
+
+  m_direct = false;
+}
+
+#else
+
+DirectFileTape::DirectFileTape(const std::string &, const size_t,
+                               const TapeConfig &config, Durability durability)
+    : m_currentPosition(0), m_size(0), m_maxSize(0), m_fd(-1), m_direct(false),
+      m_block(nullptr), m_blockIndex(0), m_dirty(false), m_config(config),
+      m_durability(durability) {
+  throw std::runtime_error("DirectFileTape is not supported on this platform");
+}
+
+DirectFileTape::~DirectFileTape() noexcept {}
+
+int DirectFileTape::read() { return 0; }
+
+void DirectFileTape::write(int) {}
+
+void DirectFileTape::moveLeft() {}
+
+void DirectFileTape::moveRight() {}
+
+void DirectFileTape::rewind() {}
+
+bool DirectFileTape::isAtEnd() const { return true; }
+
+size_t DirectFileTape::getSize() const { return 0; }
+
+void DirectFileTape::sync() {}
+
+size_t DirectFileTape::getMaxSize() const { return 0; }
+
+std::string DirectFileTape::getFilename() const { return m_filename; }
+
+bool DirectFileTape::isDirect() const { return false; }
+
+bool DirectFileTape::isSupported() { return false; }
+
+#endif
+
+void DirectFileTape::applyDelay(int delay) const {
+  std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+}
@@ -0,0 +1,37 @@
+#include "../../../include/entities/streamTapes/CallbackTape.h"
+
+#include <stdexcept>
+#include <utility>
+
+CallbackTape::CallbackTape(Sink sink) : m_sink(std::move(sink)) {}
+
+int CallbackTape::read() {
+  throw std::logic_error("CallbackTape is write-only");
+}
+
+void CallbackTape::write(int data) {
+  if (m_position != m_size) {
+    throw std::logic_error("CallbackTape can only append");
+  }
+
+  m_sink(data);
+  ++m_size;
+}
+
+void CallbackTape::moveLeft() {
+  if (m_position > 0) {
+    --m_position;
+  }
+}
+
+void CallbackTape::moveRight() {
+  if (m_position < m_size) {
+    ++m_position;
+  }
+}
+
+void CallbackTape::rewind() { m_position = 0; }
+
+bool CallbackTape::isAtEnd() const { return m_position >= m_size; }
+
+size_t CallbackTape::getSize() const { return m_size; }
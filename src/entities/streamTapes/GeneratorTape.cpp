@@ -0,0 +1,57 @@
+#include "../../../include/entities/streamTapes/GeneratorTape.h"
+
+#include <stdexcept>
+#include <utility>
+
+GeneratorTape::GeneratorTape(Generator generator)
+    : m_generator(std::move(generator)) {}
+
+int GeneratorTape::read() {
+  fetch();
+
+  if (!m_current) {
+    throw std::out_of_range("Read past the end of the stream");
+  }
+
+  return *m_current;
+}
+
+void GeneratorTape::write(int) {
+  throw std::logic_error("GeneratorTape is read-only");
+}
+
+void GeneratorTape::moveLeft() {
+  throw std::logic_error("GeneratorTape cannot move left");
+}
+
+void GeneratorTape::moveRight() {
+  fetch();
+
+  if (!m_current) {
+    return;
+  }
+
+  m_fetched = false;
+  m_current.reset();
+  ++m_position;
+}
+
+void GeneratorTape::rewind() {
+  if (m_position != 0) {
+    throw std::logic_error("GeneratorTape cannot rewind a consumed stream");
+  }
+}
+
+bool GeneratorTape::isAtEnd() const {
+  fetch();
+  return !m_current;
+}
+
+size_t GeneratorTape::getSize() const { return m_position; }
+
+void GeneratorTape::fetch() const {
+  if (!m_fetched) {
+    m_current = m_generator();
+    m_fetched = true;
+  }
+}
@@ -1,8 +1,10 @@
 #include "../../include/factories/TapeConfigFactory.h"
 
 #include <algorithm>
+#include <cctype>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string_view>
@@ -15,6 +17,89 @@ void trimWhitespace(std::string &s) {
   s.erase(0, s.find_first_not_of(whitespace));
 }
 
+int parseDelay(const std::string &key, long long value) {
+  if (value > std::numeric_limits<int>::max() ||
+      value < std::numeric_limits<int>::min()) {
+    throw std::runtime_error(key + " is out of range");
+  }
+
+  return static_cast<int>(value);
+}
+
+bool parseFlag(const std::string &key, long long value) {
+  if (value != 0 && value != 1) {
+    throw std::runtime_error(key + " must be 0 or 1");
+  }
+
+  return value == 1;
+}
+
+Durability parseDurability(const std::string &key, const std::string &value) {
+  if (value == "none") {
+    return Durability::None;
+  }
+
+  if (value == "flush") {
+    return Durability::Flush;
+  }
+
+  if (value == "fsync") {
+    return Durability::Fsync;
+  }
+
+  throw std::runtime_error("Unknown " + key + ": " + value);
+}
+
+constexpr size_t kMaxDrives = 1024;
+
+/// @brief Разбирает ключ вида drive.<N>.<параметр>.
+bool parseDriveKey(const std::string &key, long long value,
+                   TapeConfig &config) {
+  constexpr auto prefix = "drive."sv;
+
+  if (key.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+
+  const size_t dot = key.find('.', prefix.size());
+  if (dot == std::string::npos || dot == prefix.size()) {
+    throw std::runtime_error("Invalid drive key: " + key);
+  }
+
+  const std::string indexStr = key.substr(prefix.size(), dot - prefix.size());
+  if (!std::all_of(indexStr.begin(), indexStr.end(),
+                   [](unsigned char c) { return std::isdigit(c); })) {
+    throw std::runtime_error("Invalid drive index: " + indexStr);
+  }
+
+  const size_t index = std::stoul(indexStr);
+  if (index >= kMaxDrives) {
+    throw std::runtime_error("Drive index is too large: " + indexStr);
+  }
+
+  if (config.drives.size() <= index) {
+    config.drives.resize(index + 1);
+  }
+
+  DriveConfig &drive = config.drives[index];
+  const std::string param = key.substr(dot + 1);
+  const int delay = parseDelay(key, value);
+
+  if (param == "read_delay") {
+    drive.readDelay = delay;
+  } else if (param == "write_delay") {
+    drive.writeDelay = delay;
+  } else if (param == "rewind_delay") {
+    drive.rewindDelay = delay;
+  } else if (param == "shift_delay") {
+    drive.shiftDelay = delay;
+  } else {
+    throw std::runtime_error("Unknown drive parameter: " + param);
+  }
+
+  return true;
+}
+
 TapeConfigFactory::TapeConfigFactory(std::string filename)
     : m_configFile(std::move(filename)) {}
 
@@ -78,23 +163,68 @@ void TapeConfigFactory::parseLine(const std::string &line,
 
   trimWhitespace(valueStr);
 
-  int value;
+  if (key == "temp_dir") {
+    if (valueStr.empty()) {
+      throw std::runtime_error("temp_dir cannot be empty");
+    }
+
+    config.tempDirs.push_back(valueStr);
+    return;
+  }
+
+  if (key == "temp_placement") {
+    if (valueStr == "round_robin") {
+      config.tempPlacement = TempPlacement::RoundRobin;
+    } else if (valueStr == "free_space") {
+      config.tempPlacement = TempPlacement::FreeSpace;
+    } else {
+      throw std::runtime_error("Unknown temp_placement: " + valueStr);
+    }
+
+    return;
+  }
+
+  if (key == "temp_durability") {
+    config.tempDurability = parseDurability(key, valueStr);
+    return;
+  }
+
+  if (key == "output_durability") {
+    config.outputDurability = parseDurability(key, valueStr);
+    return;
+  }
+
+  long long value;
   try {
-    value = std::stoi(valueStr);
+    value = std::stoll(valueStr);
   } catch (const std::exception &) {
     throw std::runtime_error("Invalid integer value: " + valueStr);
   }
 
+  if (parseDriveKey(key, value, config)) {
+    return;
+  }
+
   if (key == "read_delay") {
-    config.readDelay = value;
+    config.readDelay = parseDelay(key, value);
   } else if (key == "write_delay") {
-    config.writeDelay = value;
+    config.writeDelay = parseDelay(key, value);
   } else if (key == "rewind_delay") {
-    config.rewindDelay = value;
+    config.rewindDelay = parseDelay(key, value);
   } else if (key == "shift_delay") {
-    config.shiftDelay = value;
+    config.shiftDelay = parseDelay(key, value);
   } else if (key == "memory_limit") {
-    config.memoryLimit = value;
+    if (value < 0) {
+      throw std::runtime_error("Memory limit cannot be negative");
+    }
+
+    config.memoryLimit = static_cast<size_t>(value);
+  } else if (key == "input_direct_io") {
+    config.inputDirectIo = parseFlag(key, value);
+  } else if (key == "temp_direct_io") {
+    config.tempDirectIo = parseFlag(key, value);
+  } else if (key == "output_direct_io") {
+    config.outputDirectIo = parseFlag(key, value);
   } else {
     throw std::runtime_error("Unknown config key: " + key);
   }
@@ -111,4 +241,18 @@ void TapeConfigFactory::validateConfig(const TapeConfig &config) const {
   checkNegative(config.writeDelay, "Write delay");
   checkNegative(config.rewindDelay, "Rewind delay");
   checkNegative(config.shiftDelay, "Shift delay");
+
+  if (config.memoryLimit < sizeof(int)) {
+    throw std::runtime_error("Memory limit must hold at least one element");
+  }
+
+  for (size_t i = 0; i < config.drives.size(); ++i) {
+    const std::string name = "Drive " + std::to_string(i) + " ";
+    const DriveConfig &drive = config.drives[i];
+
+    checkNegative(drive.readDelay, name + "read delay");
+    checkNegative(drive.writeDelay, name + "write delay");
+    checkNegative(drive.rewindDelay, name + "rewind delay");
+    checkNegative(drive.shiftDelay, name + "shift delay");
+  }
 }
@@ -0,0 +1,44 @@
+#include "../../include/index/IndexingTape.h"
+
+#include <utility>
+
+IndexingTape::IndexingTape(std::unique_ptr<TapeInterface> tape,
+                           std::string indexFile, size_t blockElements)
+    : m_tape(std::move(tape)), m_indexFile(std::move(indexFile)),
+      m_index(blockElements) {}
+
+int IndexingTape::read() { return m_tape->read(); }
+
+void IndexingTape::write(int data) {
+  m_tape->write(data);
+  m_index.add(m_position, data);
+}
+
+void IndexingTape::moveLeft() {
+  m_tape->moveLeft();
+
+  if (m_position > 0) {
+    --m_position;
+  }
+}
+
+void IndexingTape::moveRight() {
+  m_tape->moveRight();
+  ++m_position;
+}
+
+void IndexingTape::rewind() {
+  m_tape->rewind();
+  m_position = 0;
+}
+
+bool IndexingTape::isAtEnd() const { return m_tape->isAtEnd(); }
+
+size_t IndexingTape::getSize() const { return m_tape->getSize(); }
+
+void IndexingTape::sync() {
+  m_tape->sync();
+  m_index.save(m_indexFile);
+}
+
+const SparseIndex &IndexingTape::getIndex() const { return m_index; }
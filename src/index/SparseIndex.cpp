@@ -0,0 +1,129 @@
+#include "../../include/index/SparseIndex.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kMagic[] = "TIDX\x01";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+
+template <typename T> void writeValue(std::ofstream &file, T value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> T readValue(std::ifstream &file) {
+  T value{};
+  file.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return value;
+}
+
+} // namespace
+
+SparseIndex::SparseIndex(size_t blockElements)
+    : m_blockElements(blockElements) {
+  if (blockElements == 0) {
+    throw std::invalid_argument("Index block size must be positive");
+  }
+}
+
+void SparseIndex::add(size_t position, int value) {
+  const size_t block = position / m_blockElements;
+
+  if (block > m_blocks.size()) {
+    throw std::out_of_range("Index blocks must be filled in order");
+  }
+
+  if (block == m_blocks.size()) {
+    m_blocks.push_back({value, block * m_blockElements});
+  } else {
+    m_blocks[block].minKey = std::min(m_blocks[block].minKey, value);
+  }
+
+  m_elements = std::max(m_elements, position + 1);
+}
+
+size_t SparseIndex::getBlockElements() const { return m_blockElements; }
+
+size_t SparseIndex::getElements() const { return m_elements; }
+
+const std::vector<SparseIndex::Block> &SparseIndex::getBlocks() const {
+  return m_blocks;
+}
+
+size_t SparseIndex::findBlock(int key) const {
+  const auto it = std::lower_bound(
+      m_blocks.begin(), m_blocks.end(), key,
+      [](const Block &block, int value) { return block.minKey < value; });
+
+  const auto index = static_cast<size_t>(it - m_blocks.begin());
+  return index == 0 ? 0 : index - 1;
+}
+
+void SparseIndex::save(const std::string &filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open index file: " + filename);
+  }
+
+  file.write(kMagic, kMagicSize);
+  writeValue<uint64_t>(file, m_blockElements);
+  writeValue<uint64_t>(file, m_elements);
+  writeValue<uint64_t>(file, m_blocks.size());
+
+  for (const Block &block : m_blocks) {
+    writeValue<int32_t>(file, block.minKey);
+    writeValue<uint64_t>(file, block.offset);
+  }
+
+  if (!file) {
+    throw std::runtime_error("Failed to write index file: " + filename);
+  }
+}
+
+SparseIndex SparseIndex::load(const std::string &filename) {
+  std::ifstream file(filename, std::ios::binary);
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open index file: " + filename);
+  }
+
+  char magic[kMagicSize] = {};
+  file.read(magic, kMagicSize);
+
+  if (!file || !std::equal(magic, magic + kMagicSize, kMagic)) {
+    throw std::runtime_error("Not an index file: " + filename);
+  }
+
+  const auto blockElements = readValue<uint64_t>(file);
+  const auto elements = readValue<uint64_t>(file);
+  const auto blocks = readValue<uint64_t>(file);
+
+  if (!file || blockElements == 0 ||
+      blocks != (elements + blockElements - 1) / blockElements) {
+    throw std::runtime_error("Corrupted index file: " + filename);
+  }
+
+  SparseIndex index(static_cast<size_t>(blockElements));
+  index.m_elements = static_cast<size_t>(elements);
+
+  for (uint64_t i = 0; i < blocks; ++i) {
+    const auto minKey = readValue<int32_t>(file);
+    const auto offset = readValue<uint64_t>(file);
+
+    if (!file || offset != i * blockElements) {
+      throw std::runtime_error("Corrupted index file: " + filename);
+    }
+
+    index.m_blocks.push_back({minKey, static_cast<size_t>(offset)});
+  }
+
+  return index;
+}
+
+std::string SparseIndex::sidecarFor(const std::string &tapeFile) {
+  return tapeFile + ".idx";
+}
@@ -0,0 +1,118 @@
+#include "../../include/index/TapeSearch.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+TapeSearch::TapeSearch(TapeInterface &tape, SparseIndex index,
+                       const TapeConfig &config)
+    : m_tape(tape), m_index(std::move(index)), m_config(config) {
+  if (m_index.getElements() != tape.getSize()) {
+    throw std::runtime_error("Index does not match the tape");
+  }
+}
+
+std::optional<size_t> TapeSearch::find(int key) {
+  int value = 0;
+
+  if (!seekLowerBound(key, value) || value != key) {
+    return std::nullopt;
+  }
+
+  return m_position;
+}
+
+size_t TapeSearch::scan(int lo, int hi,
+                        const std::function<void(int)> &visit) {
+  int value = 0;
+  size_t count = 0;
+
+  if (lo > hi || !seekLowerBound(lo, value)) {
+    return 0;
+  }
+
+  while (value <= hi) {
+    visit(value);
+    ++count;
+
+    if (*m_position + 1 == m_tape.getSize()) {
+      break;
+    }
+
+    moveRight();
+    value = m_tape.read();
+  }
+
+  return count;
+}
+
+size_t TapeSearch::getShifts() const { return m_shifts; }
+
+size_t TapeSearch::getRewinds() const { return m_rewinds; }
+
+bool TapeSearch::seekLowerBound(int key, int &value) {
+  const size_t size = m_tape.getSize();
+
+  if (size == 0) {
+    return false;
+  }
+
+  // Элементы меньше key занимают не больше блока перед искомым.
+  seek(m_index.getBlocks()[m_index.findBlock(key)].offset);
+
+  while (true) {
+    value = m_tape.read();
+
+    if (value >= key) {
+      return true;
+    }
+
+    if (*m_position + 1 == size) {
+      return false;
+    }
+
+    moveRight();
+  }
+}
+
+void TapeSearch::seek(size_t position) {
+  if (!m_position) {
+    m_tape.rewind();
+    ++m_rewinds;
+    m_position = 0;
+  }
+
+  const size_t current = *m_position;
+
+  if (position < current) {
+    // Время и число операций: при равном времени меньше операций.
+    const auto shift = static_cast<int64_t>(m_config.shiftDelay);
+    const std::pair<int64_t, size_t> back{
+        shift * static_cast<int64_t>(current - position), current - position};
+    const std::pair<int64_t, size_t> fromStart{
+        m_config.rewindDelay + shift * static_cast<int64_t>(position),
+        position + 1};
+
+    if (fromStart < back) {
+      m_tape.rewind();
+      ++m_rewinds;
+      m_position = 0;
+    }
+  }
+
+  while (*m_position > position) {
+    m_tape.moveLeft();
+    ++m_shifts;
+    --*m_position;
+  }
+
+  while (*m_position < position) {
+    moveRight();
+  }
+}
+
+void TapeSearch::moveRight() {
+  m_tape.moveRight();
+  ++m_shifts;
+  ++*m_position;
+}
@@ -1,52 +1,441 @@
+#include "../include/daemon/SortDaemon.h"
+
+#include "../include/entities/SampleSorter.h"
+#include "../include/entities/SortVerification.h"
 #include "../include/entities/TapeConfig.h"
 #include "../include/entities/TapeSorter.h"
 
 #include "../include/factories/TapeConfigFactory.h"
 
+#include "../include/index/IndexingTape.h"
+#include "../include/index/SparseIndex.h"
+#include "../include/index/TapeSearch.h"
+
 #include "../include/interfaces/TapeInterface.h"
 
+#include "../include/trace/TraceRecorder.h"
+#include "../include/trace/TraceReplayer.h"
+#include "../include/trace/TracingTape.h"
+
+#include "../include/utils/cliOptions.hpp"
 #include "../include/utils/utils.hpp"
 
+#include <csignal>
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
-int main(int argc, char *argv[]) {
-  if (argc < 3) {
-    std::cerr << "Usage: " << argv[0]
-              << " <input_file> <output_file> [config_file]\n";
-    return 1;
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int) { stopRequested = 1; }
+
+void printStats(const SortStats &stats) {
+  std::cout << "runs: " << stats.runs << '\n'
+            << "merge passes: " << stats.mergePasses << '\n'
+            << "rewinds: " << stats.rewinds << '\n'
+            << "merged elements: " << stats.mergedElements << '\n'
+            << "counting sort: " << (stats.countingSort ? "yes" : "no")
+            << '\n';
+}
+
+void printSketch(const DataSketch &sketch) {
+  const KllSketch &quantiles = sketch.quantiles;
+
+  std::cout << "count: " << quantiles.getCount() << '\n';
+
+  if (quantiles.getCount() == 0) {
+    return;
+  }
+
+  std::cout << "min: " << quantiles.getMin() << '\n'
+            << "max: " << quantiles.getMax() << '\n';
+
+  for (int decile = 1; decile < 10; ++decile) {
+    std::cout << "p" << decile * 10 << ": "
+              << quantiles.quantile(decile / 10.0) << '\n';
+  }
+
+  const EquiWidthHistogram &histogram = sketch.histogram;
+  const std::vector<size_t> &counts = histogram.getCounts();
+
+  for (size_t i = 0; i < counts.size(); ++i) {
+    const int64_t low =
+        histogram.getLow() + static_cast<int64_t>(i) * histogram.getWidth();
+
+    std::cout << "[" << low << ", " << low + histogram.getWidth()
+              << "): " << counts[i] << '\n';
+  }
+}
+
+/// @brief Без входа verifySorted копирует в input контрольную сумму
+/// выхода, поэтому строка сравнения сумм тогда не выводится.
+void printVerification(const SortVerification &verification,
+                       bool hasInput = true) {
+  std::cout << "elements: " << verification.output.count << '\n'
+            << "sorted: " << (verification.sorted ? "yes" : "no") << '\n';
+
+  if (!verification.sorted) {
+    std::cout << "first unsorted: " << verification.firstUnsorted << '\n';
+  }
+
+  std::cout << "checksum: " << std::hex << verification.output.sum
+            << std::dec << '\n';
+
+  if (hasInput) {
+    std::cout << "checksum matches input: "
+              << (verification.input == verification.output ? "yes" : "no")
+              << '\n';
+  }
+}
+
+/// @brief Оборачивает ленту в TracingTape, если трассировка включена.
+std::unique_ptr<TapeInterface> traced(std::unique_ptr<TapeInterface> tape,
+                                      TraceRecorder *recorder) {
+  if (recorder == nullptr) {
+    return tape;
+  }
+
+  return std::make_unique<TracingTape>(std::move(tape), *recorder);
+}
+
+/// @brief Оборачивает выходную ленту в IndexingTape, если задан --index:
+/// индекс ляжет рядом с файлом выхода.
+std::unique_ptr<TapeInterface> indexed(std::unique_ptr<TapeInterface> tape,
+                                       const utils::CliOptions &options) {
+  if (options.indexBlock == 0) {
+    return tape;
   }
 
-  const fs::path inputPath(argv[1]);
-  const fs::path outputPath(argv[2]);
-  const std::string configFile = (argc > 3) ? argv[3] : "";
+  return std::make_unique<IndexingTape>(
+      std::move(tape), SparseIndex::sidecarFor(options.outputFile),
+      options.indexBlock);
+}
+
+/// @brief Вызывает run с тегом порядка из --order и --stable, выбирая
+/// заранее инстанцированный BasicTapeSorter. Для asc и desc равные int
+/// неотличимы, поэтому --stable ничего не меняет.
+template <typename Run>
+void withOrder(const utils::CliOptions &options, Run &&run) {
+  switch (options.order) {
+  case utils::OrderOption::Ascending:
+    run(Ascending{});
+    break;
+  case utils::OrderOption::Descending:
+    run(Descending{});
+    break;
+  case utils::OrderOption::Magnitude:
+    if (options.stable) {
+      run(StableByMagnitude{});
+    } else {
+      run(ByMagnitude{});
+    }
+    break;
+  }
+}
+
+/// @brief Открывает уже существующий файл для чтения. createTape создал
+/// бы отсутствующий файл, и опечатка в пути молча дала бы пустую ленту.
+std::unique_ptr<TapeInterface> openExisting(const std::string &file,
+                                            const TapeConfig &config) {
+  if (!fs::is_regular_file(file)) {
+    throw std::runtime_error("File does not exist: " + file);
+  }
+
+  return utils::createTape(utils::getFileSize(file), config, file,
+                           utils::getFileExtension(file),
+                           config.inputDirectIo);
+}
+
+std::unique_ptr<TraceRecorder> openTrace(const utils::CliOptions &options) {
+  if (options.traceFile.empty()) {
+    return nullptr;
+  }
+
+  return std::make_unique<TraceRecorder>(options.traceFile);
+}
+
+void runMerge(const utils::CliOptions &options, const TapeConfig &config) {
+  const std::string outputExt = utils::getFileExtension(options.outputFile);
+
+  const auto recorder = openTrace(options);
+
+  std::vector<std::unique_ptr<TapeInterface>> inputTapes;
+  std::vector<TapeInterface *> inputs;
+  size_t totalSize = 0;
+
+  for (const auto &inputFile : options.mergeInputs) {
+    const std::string inputExt = utils::getFileExtension(inputFile);
+    utils::validateExtensions(inputExt, outputExt);
+
+    inputTapes.push_back(
+        traced(openExisting(inputFile, config), recorder.get()));
+    totalSize += utils::getFileSize(inputFile);
+    inputs.push_back(inputTapes.back().get());
+  }
+
+  utils::clearFile(options.outputFile);
+
+  auto outputTape = indexed(
+      traced(utils::createTape(totalSize, config, options.outputFile,
+                               outputExt, config.outputDirectIo,
+                               config.outputDurability),
+             recorder.get()),
+      options);
+
+  withOrder(options, [&](auto order) {
+    BasicTapeSorter<decltype(order)> sorter(config.memoryLimit, config);
+    sorter.setTraceRecorder(recorder.get());
+    sorter.mergeSorted(inputs, *outputTape, options.assumeSorted);
+  });
+}
+
+void runSort(const utils::CliOptions &options, const TapeConfig &config) {
+  const fs::path inputPath(options.inputFile);
+  const fs::path outputPath(options.outputFile);
 
   const std::string inputExt = utils::getFileExtension(inputPath.string());
   const std::string outputExt = utils::getFileExtension(outputPath.string());
 
-  try {
-    utils::validateExtensions(inputExt, outputExt);
-    utils::clearFile(outputPath.string());
+  utils::validateExtensions(inputExt, outputExt);
+  utils::clearFile(outputPath.string());
 
-    auto configFactory = std::make_unique<TapeConfigFactory>(configFile);
-    TapeConfig config = configFactory->create();
+  const auto recorder = openTrace(options);
+
+  std::unique_ptr<TapeInterface> inputTape;
+  std::unique_ptr<TapeInterface> outputTape;
+
+  const size_t inputFileSize = utils::getFileSize(inputPath.string());
+
+  inputTape = traced(utils::createTape(inputFileSize, config,
+                                       inputPath.string(), inputExt,
+                                       config.inputDirectIo),
+                     recorder.get());
+
+  if (options.mode == utils::SortMode::SampleSort) {
+    SampleSorter sorter(config.memoryLimit, config, options.partitions);
+    sorter.setMergeStrategy(options.mergeStrategy);
+    sorter.setTraceRecorder(recorder.get());
+
+    if (options.keepPartitions) {
+      fs::remove(outputPath);
+
+      fs::path prefix = outputPath;
+      prefix.replace_extension();
 
-    std::unique_ptr<TapeInterface> inputTape;
-    std::unique_ptr<TapeInterface> outputTape;
+      for (const auto &file : sorter.sortToPartitions(*inputTape,
+                                                      prefix.string())) {
+        std::cout << file << '\n';
+      }
+    } else {
+      outputTape = indexed(
+          traced(utils::createTape(inputFileSize, config, outputPath.string(),
+                                   outputExt, config.outputDirectIo,
+                                   config.outputDurability),
+                 recorder.get()),
+          options);
+      sorter.sort(*inputTape, *outputTape);
+    }
 
-    const size_t inputFileSize = utils::getFileSize(inputPath.string());
+    if (options.printStats) {
+      printStats(sorter.getStats());
+    }
 
-    inputTape =
-        utils::createTape(inputFileSize, config, inputPath.string(), inputExt);
-    outputTape = utils::createTape(inputFileSize, config, outputPath.string(),
-                                   outputExt);
+    return;
+  }
+
+  outputTape = indexed(traced(utils::createTape(inputFileSize, config,
+                                                outputPath.string(), outputExt,
+                                                config.outputDirectIo,
+                                                config.outputDurability),
+                              recorder.get()),
+                       options);
+
+  SortStats stats;
+
+  withOrder(options, [&](auto order) {
+    BasicTapeSorter<decltype(order)> sorter(config.memoryLimit, config);
+    sorter.setMergeStrategy(options.mergeStrategy);
+    sorter.setMergeThreads(options.mergeThreads);
+    sorter.setTraceRecorder(recorder.get());
+    sorter.setSketch(options.sketchBins);
+    sorter.setVerify(options.verify);
+
+    if (options.mode == utils::SortMode::TopK) {
+      sorter.sortTopK(*inputTape, *outputTape, options.topK);
+    } else {
+      sorter.sort(*inputTape, *outputTape);
+    }
+
+    stats = sorter.getStats();
+  });
+
+  if (options.printStats) {
+    printStats(stats);
+  }
+
+  if (stats.sketch) {
+    printSketch(*stats.sketch);
+  }
+
+  if (stats.verification) {
+    printVerification(*stats.verification);
+  }
+}
+
+void runVerify(const utils::CliOptions &options, const TapeConfig &config) {
+  auto output = openExisting(options.outputFile, config);
+  std::unique_ptr<TapeInterface> input;
+
+  if (!options.inputFile.empty()) {
+    input = openExisting(options.inputFile, config);
+  }
+
+  SortVerification verification;
+
+  withOrder(options, [&](auto order) {
+    verification =
+        verifySorted(*output, input.get(), &decltype(order)::less);
+  });
+
+  printVerification(verification, input != nullptr);
+
+  if (!verification.ok()) {
+    throw std::runtime_error("Verification failed");
+  }
+}
+
+void runSketch(const utils::CliOptions &options, const TapeConfig &config) {
+  auto tape = openExisting(options.inputFile, config);
+
+  TapeSorter sorter(config.memoryLimit, config);
+  printSketch(sorter.sketch(*tape, options.sketchBins));
+}
+
+void runLookup(const utils::CliOptions &options, const TapeConfig &config) {
+  const std::string &file = options.lookupFile;
+  auto tape = openExisting(file, config);
+
+  TapeSearch search(*tape, SparseIndex::load(SparseIndex::sidecarFor(file)),
+                    config);
+
+  const size_t found =
+      search.scan(options.lookupLo, options.lookupHi,
+                  [](int value) { std::cout << value << '\n'; });
+
+  if (options.printStats) {
+    std::cout << "found: " << found << '\n'
+              << "shifts: " << search.getShifts() << '\n'
+              << "rewinds: " << search.getRewinds() << '\n';
+  }
+}
+
+void runReplay(const utils::CliOptions &options, const TapeConfig &config) {
+  const TraceReplayer replayer(options.replayFile);
+  const TraceSummary &summary = replayer.getSummary();
+
+  std::cout << "tapes: " << summary.tapes << '\n'
+            << "reads: " << summary.count(TraceOp::Read) << '\n'
+            << "writes: " << summary.count(TraceOp::Write) << '\n'
+            << "shifts: "
+            << summary.count(TraceOp::MoveLeft) +
+                   summary.count(TraceOp::MoveRight)
+            << '\n'
+            << "rewinds: " << summary.count(TraceOp::Rewind) << '\n'
+            << "sequential time: " << replayer.simulate(config) << " ms\n";
+
+  if (options.replayDrives != 0) {
+    std::cout << options.replayDrives << " drives time: "
+              << replayer.simulate(config, options.replayDrives) << " ms\n";
+  }
+
+  if (!config.drives.empty()) {
+    std::cout << "configured drives time: "
+              << replayer.simulate(config.drives) << " ms\n";
+  }
+}
+
+void runDaemon(const utils::CliOptions &options, const TapeConfig &config) {
+  DaemonOptions daemonOptions;
+  daemonOptions.spoolDir = options.spoolDir;
+
+  if (options.workers != 0) {
+    daemonOptions.workers = options.workers;
+  }
+
+  if (options.memoryBudget != 0) {
+    daemonOptions.memoryBudget = options.memoryBudget;
+  }
+
+  if (options.tempDiskBudget != 0) {
+    daemonOptions.tempDiskBudget = options.tempDiskBudget;
+  }
+
+  SortDaemon daemon(config, daemonOptions);
+
+  daemon.setJobCallback([](const JobMetrics &metrics) {
+    std::cout << metrics.name << ": ";
+
+    if (!metrics.succeeded) {
+      std::cout << "failed: " << metrics.error << std::endl;
+      return;
+    }
+
+    std::cout << metrics.elements << " elements, wait " << metrics.waitMs
+              << " ms, run " << metrics.runMs << " ms, "
+              << metrics.stats.runs << " runs" << std::endl;
+  });
+
+  if (options.once) {
+    daemon.poll();
+    daemon.waitIdle();
+    return;
+  }
+
+  std::signal(SIGINT, requestStop);
+  std::signal(SIGTERM, requestStop);
+
+  daemon.serve([] { return stopRequested != 0; });
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  utils::CliOptions options;
+
+  try {
+    options = utils::parseArguments(argc, argv);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << '\n' << utils::usage(argv[0]);
+    return 1;
+  }
+
+  try {
+    auto configFactory =
+        std::make_unique<TapeConfigFactory>(options.configFile);
+    TapeConfig config = configFactory->create();
 
-    TapeSorter sorter(12, config);
-    sorter.sort(*inputTape, *outputTape);
+    if (options.mode == utils::SortMode::Merge) {
+      runMerge(options, config);
+    } else if (options.mode == utils::SortMode::Daemon) {
+      runDaemon(options, config);
+    } else if (options.mode == utils::SortMode::Replay) {
+      runReplay(options, config);
+    } else if (options.mode == utils::SortMode::Lookup) {
+      runLookup(options, config);
+    } else if (options.mode == utils::SortMode::Sketch) {
+      runSketch(options, config);
+    } else if (options.mode == utils::SortMode::Verify) {
+      runVerify(options, config);
+    } else {
+      runSort(options, config);
+    }
 
   } catch (const std::exception &e) {
     std::cerr << "Error: \n" << e.what() << '\n';
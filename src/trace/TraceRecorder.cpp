@@ -0,0 +1,69 @@
+#include "../../include/trace/TraceRecorder.h"
+
+#include <stdexcept>
+
+TraceRecorder::TraceRecorder(const std::string &filename)
+    : m_file(filename, std::ios::binary | std::ios::trunc) {
+  if (!m_file.is_open()) {
+    throw std::runtime_error("Failed to open trace file: " + filename);
+  }
+
+  m_buffer.reserve(kBufferSize);
+  m_file.write("TSTR\x01", 5);
+}
+
+TraceRecorder::~TraceRecorder() {
+  try {
+    flush();
+  } catch (...) {
+  }
+}
+
+uint32_t TraceRecorder::registerTape() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_nextTapeId++;
+}
+
+void TraceRecorder::record(uint32_t tapeId, TraceOp op) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_buffer.size() + 6 > kBufferSize) {
+    flushLocked();
+  }
+
+  const auto code = static_cast<uint8_t>(op);
+
+  if (tapeId < 31) {
+    m_buffer.push_back(static_cast<uint8_t>(code | (tapeId << 3)));
+    return;
+  }
+
+  m_buffer.push_back(static_cast<uint8_t>(code | (31u << 3)));
+
+  do {
+    uint8_t byte = tapeId & 0x7F;
+    tapeId >>= 7;
+
+    if (tapeId != 0) {
+      byte |= 0x80;
+    }
+
+    m_buffer.push_back(byte);
+  } while (tapeId != 0);
+}
+
+void TraceRecorder::flush() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  flushLocked();
+}
+
+void TraceRecorder::flushLocked() {
+  m_file.write(reinterpret_cast<const char *>(m_buffer.data()),
+               static_cast<std::streamsize>(m_buffer.size()));
+  m_file.flush();
+  m_buffer.clear();
+
+  if (!m_file) {
+    throw std::runtime_error("Failed to write trace");
+  }
+}
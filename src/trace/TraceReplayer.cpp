@@ -0,0 +1,142 @@
+#include "../../include/trace/TraceReplayer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+int delayOf(const DriveConfig &drive, TraceOp op) {
+  switch (op) {
+  case TraceOp::Read:
+    return drive.readDelay;
+  case TraceOp::Write:
+    return drive.writeDelay;
+  case TraceOp::MoveLeft:
+  case TraceOp::MoveRight:
+    return drive.shiftDelay;
+  case TraceOp::Rewind:
+    return drive.rewindDelay;
+  }
+
+  return 0;
+}
+
+DriveConfig driveOf(const TapeConfig &config) {
+  return {config.readDelay, config.writeDelay, config.rewindDelay,
+          config.shiftDelay};
+}
+
+} // namespace
+
+template <typename Visitor>
+void TraceReplayer::forEach(Visitor &&visitor) const {
+  std::ifstream file(m_filename, std::ios::binary);
+
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open trace file: " + m_filename);
+  }
+
+  char header[5] = {};
+  if (!file.read(header, sizeof(header)) ||
+      std::memcmp(header, "TSTR\x01", sizeof(header)) != 0) {
+    throw std::runtime_error("Not a trace file: " + m_filename);
+  }
+
+  std::vector<char> buffer(64 * 1024);
+  size_t pos = 0;
+  size_t end = 0;
+
+  const auto next = [&](uint8_t &byte) {
+    if (pos == end) {
+      file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      end = static_cast<size_t>(file.gcount());
+      pos = 0;
+
+      if (end == 0) {
+        return false;
+      }
+    }
+
+    byte = static_cast<uint8_t>(buffer[pos++]);
+    return true;
+  };
+
+  uint8_t byte = 0;
+
+  while (next(byte)) {
+    const uint8_t code = byte & 0x07;
+    uint32_t tapeId = byte >> 3;
+
+    if (code >= kTraceOpCount) {
+      throw std::runtime_error("Corrupted trace: unknown operation");
+    }
+
+    if (tapeId == 31) {
+      tapeId = 0;
+
+      for (int shift = 0;; shift += 7) {
+        if (shift > 28 || !next(byte)) {
+          throw std::runtime_error("Corrupted trace: bad tape id");
+        }
+
+        tapeId |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0) {
+          break;
+        }
+      }
+    }
+
+    visitor(tapeId, static_cast<TraceOp>(code));
+  }
+}
+
+TraceReplayer::TraceReplayer(std::string filename)
+    : m_filename(std::move(filename)) {
+  forEach([&](uint32_t tapeId, TraceOp op) {
+    ++m_summary.counts[static_cast<size_t>(op)];
+    m_summary.tapes = std::max(m_summary.tapes, tapeId + 1);
+  });
+}
+
+const TraceSummary &TraceReplayer::getSummary() const { return m_summary; }
+
+int64_t TraceReplayer::simulate(const TapeConfig &config) const {
+  const DriveConfig drive = driveOf(config);
+  int64_t total = 0;
+
+  for (size_t op = 0; op < kTraceOpCount; ++op) {
+    total += static_cast<int64_t>(m_summary.counts[op]) *
+             delayOf(drive, static_cast<TraceOp>(op));
+  }
+
+  return total;
+}
+
+int64_t
+TraceReplayer::simulate(const std::vector<DriveConfig> &drives) const {
+  if (drives.empty()) {
+    throw std::invalid_argument("At least one drive is required");
+  }
+
+  std::vector<int64_t> busyUntil(drives.size(), 0);
+  int64_t issue = 0;
+
+  forEach([&](uint32_t tapeId, TraceOp op) {
+    const size_t drive = tapeId % drives.size();
+    const int64_t start = std::max(issue, busyUntil[drive]);
+
+    busyUntil[drive] = start + delayOf(drives[drive], op);
+    issue = op == TraceOp::Read ? busyUntil[drive] : start;
+  });
+
+  return *std::max_element(busyUntil.begin(), busyUntil.end());
+}
+
+int64_t TraceReplayer::simulate(const TapeConfig &config,
+                                size_t driveCount) const {
+  return simulate(std::vector<DriveConfig>(driveCount, driveOf(config)));
+}
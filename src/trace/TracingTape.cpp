@@ -0,0 +1,74 @@
+#include "../../include/trace/TracingTape.h"
+
+#include "../../include/entities/fileTapes/BinaryFileTape.h"
+#include "../../include/entities/fileTapes/DirectFileTape.h"
+
+#include <limits>
+#include <utility>
+
+namespace {
+
+size_t maxSizeOf(const TapeInterface &tape) {
+  if (const auto *file = dynamic_cast<const BinaryFileTape *>(&tape)) {
+    return file->getMaxSize();
+  }
+
+  if (const auto *file = dynamic_cast<const DirectFileTape *>(&tape)) {
+    return file->getMaxSize();
+  }
+
+  return std::numeric_limits<size_t>::max();
+}
+
+} // namespace
+
+TracingTape::TracingTape(std::unique_ptr<TapeInterface> tape,
+                         TraceRecorder &recorder)
+    : m_tape(std::move(tape)), m_recorder(recorder),
+      m_tapeId(recorder.registerTape()), m_maxSize(maxSizeOf(*m_tape)) {}
+
+int TracingTape::read() {
+  const int value = m_tape->read();
+  m_recorder.record(m_tapeId, TraceOp::Read);
+  return value;
+}
+
+void TracingTape::write(int data) {
+  m_tape->write(data);
+  m_recorder.record(m_tapeId, TraceOp::Write);
+}
+
+void TracingTape::moveLeft() {
+  m_tape->moveLeft();
+
+  if (m_position > 0) {
+    --m_position;
+    m_recorder.record(m_tapeId, TraceOp::MoveLeft);
+  }
+}
+
+void TracingTape::moveRight() {
+  // То же условие, что у файловых лент.
+  const bool moves = m_position < m_maxSize || m_position > m_tape->getSize();
+
+  m_tape->moveRight();
+
+  if (moves) {
+    ++m_position;
+    m_recorder.record(m_tapeId, TraceOp::MoveRight);
+  }
+}
+
+void TracingTape::rewind() {
+  m_tape->rewind();
+  m_position = 0;
+  m_recorder.record(m_tapeId, TraceOp::Rewind);
+}
+
+bool TracingTape::isAtEnd() const { return m_tape->isAtEnd(); }
+
+size_t TracingTape::getSize() const { return m_tape->getSize(); }
+
+void TracingTape::sync() { m_tape->sync(); }
+
+uint32_t TracingTape::getTapeId() const { return m_tapeId; }
@@ -0,0 +1,390 @@
+#include "../../include/utils/cliOptions.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+size_t parseCount(const std::string &option, const std::string &value) {
+  size_t pos = 0;
+  unsigned long long count = 0;
+
+  try {
+    count = std::stoull(value, &pos);
+  } catch (const std::exception &) {
+    pos = 0;
+  }
+
+  if (pos != value.size() || value.empty() || value[0] == '-') {
+    throw std::invalid_argument("Invalid value for " + option + ": " + value);
+  }
+
+  return static_cast<size_t>(count);
+}
+
+int parseKey(const std::string &value) {
+  size_t pos = 0;
+  long long key = 0;
+
+  try {
+    key = std::stoll(value, &pos);
+  } catch (const std::exception &) {
+    pos = 0;
+  }
+
+  if (pos != value.size() || value.empty() ||
+      key < std::numeric_limits<int>::min() ||
+      key > std::numeric_limits<int>::max()) {
+    throw std::invalid_argument("Invalid key: " + value);
+  }
+
+  return static_cast<int>(key);
+}
+
+std::string requireValue(int argc, const char *const argv[], int &i,
+                         const std::string &option) {
+  if (i + 1 >= argc) {
+    throw std::invalid_argument("Missing value for " + option);
+  }
+
+  return argv[++i];
+}
+
+} // namespace
+
+MergeStrategy utils::parseMergeStrategy(const std::string &value) {
+  if (value == "pairwise") {
+    return MergeStrategy::Pairwise;
+  }
+
+  if (value == "backward") {
+    return MergeStrategy::ReadBackward;
+  }
+
+  if (value == "async") {
+    return MergeStrategy::Async;
+  }
+
+  if (value == "forecast") {
+    return MergeStrategy::Forecast;
+  }
+
+  throw std::invalid_argument("Unknown merge strategy: " + value +
+                              ". Expected 'pairwise', 'backward', 'async' "
+                              "or 'forecast'");
+}
+
+utils::OrderOption utils::parseOrder(const std::string &value) {
+  if (value == "asc") {
+    return OrderOption::Ascending;
+  }
+
+  if (value == "desc") {
+    return OrderOption::Descending;
+  }
+
+  if (value == "abs") {
+    return OrderOption::Magnitude;
+  }
+
+  throw std::invalid_argument("Unknown order: " + value +
+                              ". Expected 'asc', 'desc' or 'abs'");
+}
+
+utils::CliOptions utils::parseArguments(int argc, const char *const argv[]) {
+  CliOptions options;
+  std::vector<std::string> positional;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+
+    if (arg == "--top-k") {
+      options.mode = SortMode::TopK;
+      options.topK = parseCount(arg, requireValue(argc, argv, i, arg));
+    } else if (arg == "--merge") {
+      options.mode = SortMode::Merge;
+    } else if (arg == "--assume-sorted") {
+      options.assumeSorted = true;
+    } else if (arg == "--partitions") {
+      options.mode = SortMode::SampleSort;
+      options.partitions = parseCount(arg, requireValue(argc, argv, i, arg));
+
+      if (options.partitions == 0) {
+        throw std::invalid_argument("--partitions must be positive");
+      }
+    } else if (arg == "--keep-partitions") {
+      options.keepPartitions = true;
+    } else if (arg == "--merge-strategy") {
+      options.mergeStrategy =
+          parseMergeStrategy(requireValue(argc, argv, i, arg));
+    } else if (arg == "--merge-threads") {
+      options.mergeThreads =
+          parseCount(arg, requireValue(argc, argv, i, arg));
+
+      if (options.mergeThreads == 0) {
+        throw std::invalid_argument("--merge-threads must be positive");
+      }
+    } else if (arg == "--order") {
+      options.order = parseOrder(requireValue(argc, argv, i, arg));
+    } else if (arg == "--stable") {
+      options.stable = true;
+    } else if (arg == "--stats") {
+      options.printStats = true;
+    } else if (arg == "--index") {
+      options.indexBlock = parseCount(arg, requireValue(argc, argv, i, arg));
+
+      if (options.indexBlock == 0) {
+        throw std::invalid_argument("--index must be positive");
+      }
+    } else if (arg == "--sketch") {
+      options.sketchBins = parseCount(arg, requireValue(argc, argv, i, arg));
+
+      if (options.sketchBins < 2) {
+        throw std::invalid_argument("--sketch must be at least 2");
+      }
+    } else if (arg == "--sketch-only") {
+      options.mode = SortMode::Sketch;
+    } else if (arg == "--verify") {
+      options.verify = true;
+    } else if (arg == "--verify-only") {
+      options.mode = SortMode::Verify;
+    } else if (arg == "--lookup") {
+      options.mode = SortMode::Lookup;
+      options.lookupFile = requireValue(argc, argv, i, arg);
+    } else if (arg == "--daemon") {
+      options.mode = SortMode::Daemon;
+      options.spoolDir = requireValue(argc, argv, i, arg);
+    } else if (arg == "--workers") {
+      options.workers = parseCount(arg, requireValue(argc, argv, i, arg));
+
+      if (options.workers == 0) {
+        throw std::invalid_argument("--workers must be positive");
+      }
+    } else if (arg == "--memory-budget") {
+      options.memoryBudget =
+          parseCount(arg, requireValue(argc, argv, i, arg));
+    } else if (arg == "--temp-disk-budget") {
+      options.tempDiskBudget =
+          parseCount(arg, requireValue(argc, argv, i, arg));
+    } else if (arg == "--once") {
+      options.once = true;
+    } else if (arg == "--trace") {
+      options.traceFile = requireValue(argc, argv, i, arg);
+    } else if (arg == "--replay") {
+      options.mode = SortMode::Replay;
+      options.replayFile = requireValue(argc, argv, i, arg);
+    } else if (arg == "--drives") {
+      options.replayDrives = parseCount(arg, requireValue(argc, argv, i, arg));
+
+      if (options.replayDrives == 0) {
+        throw std::invalid_argument("--drives must be positive");
+      }
+    } else if (arg == "--config") {
+      options.configFile = requireValue(argc, argv, i, arg);
+    } else if (arg.rfind("--", 0) == 0) {
+      throw std::invalid_argument("Unknown option: " + arg);
+    } else {
+      positional.push_back(arg);
+    }
+  }
+
+  if (options.indexBlock != 0 && (options.mode == SortMode::Daemon ||
+                                  options.mode == SortMode::Replay ||
+                                  options.mode == SortMode::Lookup ||
+                                  options.keepPartitions)) {
+    throw std::invalid_argument("--index is not supported with --daemon, "
+                                "--replay, --lookup or --keep-partitions");
+  }
+
+  if (options.sketchBins != 0 && options.mode != SortMode::Sort &&
+      options.mode != SortMode::TopK && options.mode != SortMode::Sketch) {
+    throw std::invalid_argument("--sketch is not supported with --merge, "
+                                "--partitions, --daemon, --replay or "
+                                "--lookup");
+  }
+
+  // Индекс и поиск по нему рассчитаны на возрастающий выход.
+  if ((options.order != OrderOption::Ascending || options.stable) &&
+      ((options.mode != SortMode::Sort && options.mode != SortMode::TopK &&
+        options.mode != SortMode::Merge && options.mode != SortMode::Verify) ||
+       options.indexBlock != 0)) {
+    throw std::invalid_argument("--order and --stable are supported only "
+                                "when sorting, with --top-k, --merge or "
+                                "--verify-only, and not with --index");
+  }
+
+  if (options.verify && options.mode != SortMode::Sort) {
+    throw std::invalid_argument("--verify is supported only when sorting "
+                                "without --top-k, --merge or --partitions");
+  }
+
+  if (options.mode == SortMode::Verify) {
+    if (positional.empty() || positional.size() > 2 ||
+        options.indexBlock != 0 || options.sketchBins != 0 ||
+        !options.traceFile.empty() || options.mergeThreads != 0) {
+      throw std::invalid_argument("Expected --verify-only <sorted_file> "
+                                  "[<input_file>] [--config file]");
+    }
+
+    options.outputFile = positional[0];
+
+    if (positional.size() > 1) {
+      options.inputFile = positional[1];
+    }
+
+    return options;
+  }
+
+  if (options.mode == SortMode::Sketch) {
+    if (positional.empty() || positional.size() > 2 ||
+        options.indexBlock != 0 || !options.traceFile.empty() ||
+        options.mergeThreads != 0) {
+      throw std::invalid_argument("Expected --sketch-only <input_file> "
+                                  "[config_file] [--sketch N]");
+    }
+
+    options.inputFile = positional[0];
+
+    if (positional.size() > 1) {
+      options.configFile = positional[1];
+    }
+
+    if (options.sketchBins == 0) {
+      options.sketchBins = kDefaultSketchBins;
+    }
+
+    return options;
+  }
+
+  if (options.replayDrives != 0 && options.mode != SortMode::Replay) {
+    throw std::invalid_argument("--drives requires --replay");
+  }
+
+  if (options.mode == SortMode::Replay) {
+    if (positional.size() > 1) {
+      throw std::invalid_argument("Expected --replay <trace_file> "
+                                  "[config_file]");
+    }
+
+    if (!positional.empty()) {
+      options.configFile = positional[0];
+    }
+
+    return options;
+  }
+
+  if (!options.traceFile.empty() && (options.mode == SortMode::Daemon ||
+                                     options.mode == SortMode::Lookup)) {
+    throw std::invalid_argument("--trace is not supported with --daemon or "
+                                "--lookup");
+  }
+
+  // Слияние уже отсортированных входов идёт через TapeView, у которого нет
+  // позиционного доступа.
+  if (options.mergeThreads != 0 && options.mode != SortMode::Sort &&
+      options.mode != SortMode::TopK) {
+    throw std::invalid_argument("--merge-threads is not supported with "
+                                "--merge, --partitions, --daemon or "
+                                "--lookup");
+  }
+
+  if (options.mode == SortMode::Daemon) {
+    if (positional.size() > 1) {
+      throw std::invalid_argument("Expected --daemon <spool_dir> "
+                                  "[config_file]");
+    }
+
+    if (!positional.empty()) {
+      options.configFile = positional[0];
+    }
+
+    return options;
+  }
+
+  if (options.workers != 0 || options.memoryBudget != 0 ||
+      options.tempDiskBudget != 0 || options.once) {
+    throw std::invalid_argument("--workers, --memory-budget, "
+                                "--temp-disk-budget and --once require "
+                                "--daemon");
+  }
+
+  if (options.mode == SortMode::Lookup) {
+    if (positional.empty() || positional.size() > 2) {
+      throw std::invalid_argument("Expected --lookup <sorted_file> <key> "
+                                  "[<hi>]");
+    }
+
+    options.lookupLo = parseKey(positional[0]);
+    options.lookupHi =
+        positional.size() > 1 ? parseKey(positional[1]) : options.lookupLo;
+
+    return options;
+  }
+
+  if (options.mode == SortMode::Merge) {
+    if (positional.size() < 2) {
+      throw std::invalid_argument("Expected <output_file> <input_file>...");
+    }
+
+    options.outputFile = positional[0];
+    options.mergeInputs.assign(positional.begin() + 1, positional.end());
+
+    return options;
+  }
+
+  if (positional.size() < 2 || positional.size() > 3) {
+    throw std::invalid_argument("Expected <input_file> <output_file> "
+                                "[config_file]");
+  }
+
+  if (options.keepPartitions && options.mode != SortMode::SampleSort) {
+    throw std::invalid_argument("--keep-partitions requires --partitions");
+  }
+
+  options.inputFile = positional[0];
+  options.outputFile = positional[1];
+
+  if (positional.size() > 2) {
+    options.configFile = positional[2];
+  }
+
+  return options;
+}
+
+std::string utils::usage(const std::string &program) {
+  return "Usage: " + program +
+         " <input_file> <output_file> [config_file] [--top-k N]\n"
+         "         [--merge-strategy pairwise|backward|async|forecast]\n"
+         "         [--order asc|desc|abs] [--stable]\n"
+         "         [--merge-threads N] [--stats] [--trace FILE] "
+         "[--index N]\n"
+         "         [--sketch N] [--verify]\n"
+         "       " +
+         program +
+         " <input_file> <output_file> [config_file] --partitions P "
+         "[--keep-partitions] [--index N]\n"
+         "         [--merge-strategy S] [--stats] [--trace FILE]\n"
+         "       " +
+         program +
+         " --merge [--assume-sorted] [--trace FILE] [--index N] "
+         "[--order O] [--stable]\n"
+         "         [--config file]\n"
+         "         <output_file> <input_file>...\n"
+         "       " +
+         program +
+         " --daemon <spool_dir> [config_file] [--workers N]\n"
+         "         [--memory-budget BYTES] [--temp-disk-budget BYTES] "
+         "[--once]\n"
+         "       " +
+         program + " --replay <trace_file> [config_file] [--drives N]\n"
+         "       " +
+         program +
+         " --lookup <sorted_file> <key> [<hi>] [--config file] [--stats]\n"
+         "       " +
+         program + " --sketch-only <input_file> [config_file] [--sketch N]\n"
+         "       " +
+         program +
+         " --verify-only <sorted_file> [<input_file>] [--order O] "
+         "[--config file]\n";
+}
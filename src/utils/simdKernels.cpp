@@ -0,0 +1,408 @@
+#include "../../include/utils/simdKernels.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                             \
+    (defined(__x86_64__) || defined(__i386__))
+#define TAPESORTER_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define TAPESORTER_SIMD_X86 0
+#endif
+
+namespace {
+
+using utils::simd::Isa;
+
+void mergeScalar(const int *a, size_t na, const int *b, size_t nb, int *out) {
+  size_t i = 0;
+  size_t j = 0;
+
+  while (i < na && j < nb) {
+    *out++ = b[j] < a[i] ? b[j++] : a[i++];
+  }
+
+  out = std::copy(a + i, a + na, out);
+  std::copy(b + j, b + nb, out);
+}
+
+/// @brief Досливает остаток векторного слияния: блок carry (все его
+/// элементы не меньше уже выведенных) и хвосты обоих входов.
+void mergeTail(const int *carry, size_t nc, const int *a, size_t na,
+               const int *b, size_t nb, int *out) {
+  size_t c = 0;
+  size_t i = 0;
+  size_t j = 0;
+
+  while (c < nc) {
+    const bool hasA = i < na;
+    const bool hasB = j < nb;
+
+    if (hasA && a[i] < carry[c] && (!hasB || a[i] <= b[j])) {
+      *out++ = a[i++];
+    } else if (hasB && b[j] < carry[c]) {
+      *out++ = b[j++];
+    } else {
+      *out++ = carry[c++];
+    }
+  }
+
+  mergeScalar(a + i, na - i, b + j, nb - j, out);
+}
+
+/// @brief Восходящее слияние серий длины width, уже отсортированных в
+/// data; результат остаётся в data.
+void mergeRuns(int *data, int *scratch, size_t n, size_t width, Isa isa) {
+  int *src = data;
+  int *dst = scratch;
+
+  for (; width < n; width *= 2) {
+    for (size_t lo = 0; lo < n; lo += 2 * width) {
+      const size_t mid = std::min(lo + width, n);
+      const size_t hi = std::min(lo + 2 * width, n);
+      utils::simd::merge(src + lo, mid - lo, src + mid, hi - mid, dst + lo,
+                         isa);
+    }
+
+    std::swap(src, dst);
+  }
+
+  if (src != data) {
+    std::memcpy(data, src, n * sizeof(int));
+  }
+}
+
+#if TAPESORTER_SIMD_X86
+
+// ---------------------------------------------------------------- SSE4.1
+
+__attribute__((target("sse4.1"))) inline void
+minMax4(__m128i &a, __m128i &b) {
+  const __m128i lo = _mm_min_epi32(a, b);
+  b = _mm_max_epi32(a, b);
+  a = lo;
+}
+
+/// @brief Сортирует битоническую последовательность из 4 элементов.
+__attribute__((target("sse4.1"))) inline __m128i bitonicSort4(__m128i v) {
+  __m128i t = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  v = _mm_blend_epi16(_mm_min_epi32(v, t), _mm_max_epi32(v, t), 0xF0);
+
+  t = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_blend_epi16(_mm_min_epi32(v, t), _mm_max_epi32(v, t), 0xCC);
+}
+
+/// @brief Сливает два отсортированных вектора: lo — 4 наименьших, hi — 4
+/// наибольших элемента, оба по возрастанию.
+__attribute__((target("sse4.1"))) inline void merge4(__m128i &lo,
+                                                     __m128i &hi) {
+  hi = _mm_shuffle_epi32(hi, _MM_SHUFFLE(0, 1, 2, 3));
+  minMax4(lo, hi);
+  lo = bitonicSort4(lo);
+  hi = bitonicSort4(hi);
+}
+
+__attribute__((target("sse4.1"))) void mergeSse41(const int *a, size_t na,
+                                                  const int *b, size_t nb,
+                                                  int *out) {
+  constexpr size_t kWidth = 4;
+
+  if (na < kWidth || nb < kWidth) {
+    mergeScalar(a, na, b, nb, out);
+    return;
+  }
+
+  __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+  __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+  size_t i = kWidth;
+  size_t j = kWidth;
+
+  merge4(lo, hi);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), lo);
+  out += kWidth;
+
+  while (i + kWidth <= na && j + kWidth <= nb) {
+    const int *next = nullptr;
+
+    if (a[i] <= b[j]) {
+      next = a + i;
+      i += kWidth;
+    } else {
+      next = b + j;
+      j += kWidth;
+    }
+
+    lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(next));
+    merge4(lo, hi);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), lo);
+    out += kWidth;
+  }
+
+  alignas(16) int carry[kWidth];
+  _mm_store_si128(reinterpret_cast<__m128i *>(carry), hi);
+  mergeTail(carry, kWidth, a + i, na - i, b + j, nb - j, out);
+}
+
+__attribute__((target("sse4.1"))) void sortBlocksSse41(int *data,
+                                                       size_t n) {
+  // 16 элементов: 4 вектора, сеть из 5 компараторов сортирует столбцы,
+  // транспонирование превращает их в 4 отсортированные строки.
+  for (size_t base = 0; base + 16 <= n; base += 16) {
+    __m128i *p = reinterpret_cast<__m128i *>(data + base);
+    __m128i r0 = _mm_loadu_si128(p);
+    __m128i r1 = _mm_loadu_si128(p + 1);
+    __m128i r2 = _mm_loadu_si128(p + 2);
+    __m128i r3 = _mm_loadu_si128(p + 3);
+
+    minMax4(r0, r1);
+    minMax4(r2, r3);
+    minMax4(r0, r2);
+    minMax4(r1, r3);
+    minMax4(r1, r2);
+
+    const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+    _mm_storeu_si128(p, _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128(p + 2, _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128(p + 3, _mm_unpackhi_epi64(t2, t3));
+  }
+}
+
+// ------------------------------------------------------------------ AVX2
+
+__attribute__((target("avx2"))) inline void minMax8(__m256i &a, __m256i &b) {
+  const __m256i lo = _mm256_min_epi32(a, b);
+  b = _mm256_max_epi32(a, b);
+  a = lo;
+}
+
+/// @brief Сортирует битоническую последовательность из 8 элементов.
+__attribute__((target("avx2"))) inline __m256i bitonicSort8(__m256i v) {
+  __m256i t = _mm256_permute2x128_si256(v, v, 1);
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t),
+                         0xF0);
+
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t),
+                         0xCC);
+
+  t = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm256_blend_epi32(_mm256_min_epi32(v, t), _mm256_max_epi32(v, t),
+                            0xAA);
+}
+
+/// @brief Сливает два отсортированных вектора: lo — 8 наименьших, hi — 8
+/// наибольших элементов, оба по возрастанию.
+__attribute__((target("avx2"))) inline void merge8(__m256i &lo, __m256i &hi) {
+  const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  hi = _mm256_permutevar8x32_epi32(hi, reverse);
+  minMax8(lo, hi);
+  lo = bitonicSort8(lo);
+  hi = bitonicSort8(hi);
+}
+
+__attribute__((target("avx2"))) void mergeAvx2(const int *a, size_t na,
+                                               const int *b, size_t nb,
+                                               int *out) {
+  constexpr size_t kWidth = 8;
+
+  if (na < kWidth || nb < kWidth) {
+    mergeScalar(a, na, b, nb, out);
+    return;
+  }
+
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+  __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b));
+  size_t i = kWidth;
+  size_t j = kWidth;
+
+  merge8(lo, hi);
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), lo);
+  out += kWidth;
+
+  // Следующий блок берётся из входа с меньшим первым элементом: тогда
+  // выведенные 8 элементов не больше всего, что осталось.
+  while (i + kWidth <= na && j + kWidth <= nb) {
+    const int *next = nullptr;
+
+    if (a[i] <= b[j]) {
+      next = a + i;
+      i += kWidth;
+    } else {
+      next = b + j;
+      j += kWidth;
+    }
+
+    lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(next));
+    merge8(lo, hi);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), lo);
+    out += kWidth;
+  }
+
+  alignas(32) int carry[kWidth];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(carry), hi);
+  mergeTail(carry, kWidth, a + i, na - i, b + j, nb - j, out);
+}
+
+__attribute__((target("avx2"))) void sortBlocksAvx2(int *data, size_t n) {
+  // 64 элемента: 8 векторов, сеть из 19 компараторов сортирует столбцы,
+  // транспонирование 8x8 превращает их в 8 отсортированных строк.
+  for (size_t base = 0; base + 64 <= n; base += 64) {
+    __m256i *p = reinterpret_cast<__m256i *>(data + base);
+    __m256i r[8];
+
+    for (int k = 0; k < 8; ++k) {
+      r[k] = _mm256_loadu_si256(p + k);
+    }
+
+    minMax8(r[0], r[2]);
+    minMax8(r[1], r[3]);
+    minMax8(r[4], r[6]);
+    minMax8(r[5], r[7]);
+    minMax8(r[0], r[4]);
+    minMax8(r[1], r[5]);
+    minMax8(r[2], r[6]);
+    minMax8(r[3], r[7]);
+    minMax8(r[0], r[1]);
+    minMax8(r[2], r[3]);
+    minMax8(r[4], r[5]);
+    minMax8(r[6], r[7]);
+    minMax8(r[2], r[4]);
+    minMax8(r[3], r[5]);
+    minMax8(r[1], r[4]);
+    minMax8(r[3], r[6]);
+    minMax8(r[1], r[2]);
+    minMax8(r[3], r[4]);
+    minMax8(r[5], r[6]);
+
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    _mm256_storeu_si256(p + 0, _mm256_permute2x128_si256(u0, u4, 0x20));
+    _mm256_storeu_si256(p + 1, _mm256_permute2x128_si256(u1, u5, 0x20));
+    _mm256_storeu_si256(p + 2, _mm256_permute2x128_si256(u2, u6, 0x20));
+    _mm256_storeu_si256(p + 3, _mm256_permute2x128_si256(u3, u7, 0x20));
+    _mm256_storeu_si256(p + 4, _mm256_permute2x128_si256(u0, u4, 0x31));
+    _mm256_storeu_si256(p + 5, _mm256_permute2x128_si256(u1, u5, 0x31));
+    _mm256_storeu_si256(p + 6, _mm256_permute2x128_si256(u2, u6, 0x31));
+    _mm256_storeu_si256(p + 7, _mm256_permute2x128_si256(u3, u7, 0x31));
+  }
+}
+
+#endif // TAPESORTER_SIMD_X86
+
+Isa supportedIsa(Isa requested) {
+  return std::min(requested, utils::simd::detectIsa());
+}
+
+} // namespace
+
+utils::simd::Isa utils::simd::detectIsa() {
+#if TAPESORTER_SIMD_X86
+  static const Isa detected = [] {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+      return Isa::Avx2;
+    }
+
+    if (__builtin_cpu_supports("sse4.1")) {
+      return Isa::Sse41;
+    }
+
+    return Isa::Scalar;
+  }();
+
+  return detected;
+#else
+  return Isa::Scalar;
+#endif
+}
+
+const char *utils::simd::isaName(Isa isa) {
+  switch (isa) {
+  case Isa::Avx2:
+    return "avx2";
+  case Isa::Sse41:
+    return "sse4.1";
+  case Isa::Scalar:
+    break;
+  }
+
+  return "scalar";
+}
+
+void utils::simd::merge(const int *a, size_t na, const int *b, size_t nb,
+                        int *out, Isa isa) {
+  switch (supportedIsa(isa)) {
+#if TAPESORTER_SIMD_X86
+  case Isa::Avx2:
+    mergeAvx2(a, na, b, nb, out);
+    return;
+  case Isa::Sse41:
+    mergeSse41(a, na, b, nb, out);
+    return;
+#endif
+  default:
+    mergeScalar(a, na, b, nb, out);
+  }
+}
+
+void utils::simd::merge(const int *a, size_t na, const int *b, size_t nb,
+                        int *out) {
+  merge(a, na, b, nb, out, detectIsa());
+}
+
+void utils::simd::sort(int *data, size_t n, Isa isa) {
+  isa = supportedIsa(isa);
+
+  if (n > kMaxSmallSort || isa == Isa::Scalar) {
+    std::sort(data, data + n);
+    return;
+  }
+
+  // Неполный последний блок дополняется INT_MAX: после сортировки эти
+  // значения оказываются в конце и отбрасываются.
+  const size_t block = isa == Isa::Avx2 ? 64 : 16;
+  const size_t padded = (n + block - 1) / block * block;
+
+  int buffer[kMaxSmallSort];
+  int scratch[kMaxSmallSort];
+
+  std::copy(data, data + n, buffer);
+  std::fill(buffer + n, buffer + padded, INT_MAX);
+
+#if TAPESORTER_SIMD_X86
+  if (isa == Isa::Avx2) {
+    sortBlocksAvx2(buffer, padded);
+  } else {
+    sortBlocksSse41(buffer, padded);
+  }
+#endif
+
+  mergeRuns(buffer, scratch, padded, isa == Isa::Avx2 ? 8 : 4, isa);
+  std::copy(buffer, buffer + n, data);
+}
+
+void utils::simd::sort(int *data, size_t n) { sort(data, n, detectIsa()); }
@@ -1,12 +1,16 @@
 #include "../../include/utils/utils.hpp"
 #include "../../include/entities/TapeConfig.h"
+#include "../../include/entities/TapeView.h"
 #include "../../include/entities/fileTapes/BinaryFileTape.h"
+#include "../../include/entities/fileTapes/DirectFileTape.h"
 #include "../../include/interfaces/TapeInterface.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <stdexcept>
+#include <system_error>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -41,10 +45,12 @@ std::string utils::getFileExtension(const std::string &filename) {
 std::unique_ptr<TapeInterface> utils::createTape(const size_t maxSize,
                                                  const TapeConfig &config,
                                                  const std::string &filename,
-                                                 const std::string &ext) {
+                                                 const std::string &ext,
+                                                 bool directIo,
+                                                 Durability durability) {
 
   if (ext == ".bin") {
-    return std::make_unique<BinaryFileTape>(filename, maxSize, config);
+    return createFileTape(maxSize, config, filename, directIo, durability);
   }
 
   throw std::invalid_argument(
@@ -52,6 +58,48 @@ std::unique_ptr<TapeInterface> utils::createTape(const size_t maxSize,
       "'. Expected '.bin'.");
 }
 
+std::unique_ptr<TapeInterface>
+utils::createFileTape(const size_t maxSize, const TapeConfig &config,
+                      const std::string &filename, bool directIo,
+                      Durability durability) {
+
+  if (directIo && DirectFileTape::isSupported()) {
+    return std::make_unique<DirectFileTape>(filename, maxSize, config,
+                                            durability);
+  }
+
+  return std::make_unique<BinaryFileTape>(filename, maxSize, config,
+                                          durability);
+}
+
+namespace {
+
+BinaryFileTape *asFileTape(TapeInterface &tape) {
+  if (auto *view = dynamic_cast<TapeView *>(&tape)) {
+    return asFileTape(view->getTape());
+  }
+
+  return dynamic_cast<BinaryFileTape *>(&tape);
+}
+
+} // namespace
+
+void utils::copyTape(TapeInterface &from, TapeInterface &to, size_t count) {
+  BinaryFileTape *source = asFileTape(from);
+  BinaryFileTape *target = asFileTape(to);
+
+  if (source != nullptr && target != nullptr && source != target) {
+    target->copyFrom(*source, count);
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    to.write(from.read());
+    to.moveRight();
+    from.moveRight();
+  }
+}
+
 void utils::clearFile(const std::string &filename) {
 
   std::ofstream file(filename, std::ios::trunc);
@@ -62,10 +110,11 @@ void utils::clearFile(const std::string &filename) {
 }
 
 size_t utils::getFileSize(const std::string &filename) {
-  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  std::error_code error;
+  const std::uintmax_t size = fs::file_size(filename, error);
 
-  if (!file.is_open())
+  if (error)
     return 0;
 
-  return static_cast<size_t>(file.tellg());
+  return static_cast<size_t>(size);
 }
@@ -0,0 +1,165 @@
+#include "../include/async/AsyncTape.h"
+#include "../include/async/TapeScheduler.h"
+#include "../include/async/Task.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+class AsyncTapeTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directory(tmpDir); }
+
+  void TearDown() override { fs::remove_all(tmpDir); }
+
+  const std::string tmpDir = "testTempAsyncTapeTest";
+
+  TapeConfig noDelays{0, 0, 0, 0};
+  TapeConfig delays{5, 3, 20, 1};
+};
+
+namespace {
+
+Task fill(AsyncTape &tape, int count) {
+  for (int i = 0; i < count; ++i) {
+    co_await tape.write(i);
+    co_await tape.moveRight();
+  }
+}
+
+Task sum(AsyncTape &tape, long long &result) {
+  co_await tape.rewind();
+
+  while (!tape.isAtEnd()) {
+    result += co_await tape.read();
+    co_await tape.moveRight();
+  }
+}
+
+Task copyBehind(AsyncTape &from, AsyncTape &to) {
+  co_await from.rewind();
+
+  while (!from.isAtEnd()) {
+    to.writeBehind(co_await from.read());
+    to.moveRightBehind();
+    co_await from.moveRight();
+  }
+
+  co_await to.drain();
+}
+
+Task fail(AsyncTape &tape) {
+  co_await tape.rewind();
+  throw std::runtime_error("tape failure");
+}
+
+Task nested(AsyncTape &tape, long long &result) {
+  co_await fill(tape, 4);
+  co_await sum(tape, result);
+}
+
+} // namespace
+
+TEST_F(AsyncTapeTest, OperationsOnOneTapeAreSerialized) {
+  BinaryFileTape storage(tmpDir + "/serial.bin", 40, noDelays);
+
+  TapeScheduler scheduler(false);
+  AsyncTape tape(scheduler, storage, delays);
+
+  long long result = 0;
+  scheduler.spawn(fill(tape, 10));
+  scheduler.run();
+  scheduler.spawn(sum(tape, result));
+  scheduler.run();
+
+  EXPECT_EQ(result, 45);
+  // 10 * (write + shift) + rewind + 10 * (read + shift)
+  EXPECT_EQ(scheduler.now(), 10 * (3 + 1) + 20 + 10 * (5 + 1));
+}
+
+TEST_F(AsyncTapeTest, DifferentTapesOverlap) {
+  BinaryFileTape first(tmpDir + "/first.bin", 40, noDelays);
+  BinaryFileTape second(tmpDir + "/second.bin", 40, noDelays);
+
+  TapeScheduler scheduler(false);
+  AsyncTape a(scheduler, first, delays);
+  AsyncTape b(scheduler, second, delays);
+
+  scheduler.spawn(fill(a, 10));
+  scheduler.spawn(fill(b, 10));
+  scheduler.run();
+
+  EXPECT_EQ(first.getSize(), 10);
+  EXPECT_EQ(second.getSize(), 10);
+
+  // Время равно времени одной ленты, а не сумме двух.
+  EXPECT_EQ(scheduler.now(), 10 * (3 + 1));
+  EXPECT_EQ(a.getBusyUntil(), scheduler.now());
+  EXPECT_EQ(b.getBusyUntil(), scheduler.now());
+}
+
+TEST_F(AsyncTapeTest, NestedTasksAndErrors) {
+  BinaryFileTape storage(tmpDir + "/nested.bin", 40, noDelays);
+
+  TapeScheduler scheduler(false);
+  AsyncTape tape(scheduler, storage, delays);
+
+  long long result = 0;
+  scheduler.spawn(nested(tape, result));
+  scheduler.run();
+  EXPECT_EQ(result, 6);
+
+  scheduler.spawn(fail(tape));
+  EXPECT_THROW(scheduler.run(), std::runtime_error);
+}
+
+TEST_F(AsyncTapeTest, RealTimeSchedulerWaitsForDelays) {
+  BinaryFileTape first(tmpDir + "/rt_first.bin", 40, noDelays);
+  BinaryFileTape second(tmpDir + "/rt_second.bin", 40, noDelays);
+
+  TapeScheduler scheduler;
+  AsyncTape a(scheduler, first, TapeConfig{0, 10, 0, 0});
+  AsyncTape b(scheduler, second, TapeConfig{0, 10, 0, 0});
+
+  const auto start = std::chrono::steady_clock::now();
+
+  scheduler.spawn(fill(a, 3));
+  scheduler.spawn(fill(b, 3));
+  scheduler.run();
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(30));
+  EXPECT_EQ(scheduler.now(), 30);
+}
+
+TEST_F(AsyncTapeTest, WriteBehindOverlapsWithReads) {
+  BinaryFileTape source(tmpDir + "/behind_source.bin", 40, noDelays);
+  BinaryFileTape target(tmpDir + "/behind_target.bin", 40, noDelays);
+
+  TapeScheduler scheduler(false);
+  AsyncTape from(scheduler, source, delays);
+  AsyncTape to(scheduler, target, delays);
+
+  scheduler.spawn(fill(from, 10));
+  scheduler.run();
+
+  const TapeScheduler::Milliseconds start = scheduler.now();
+  scheduler.spawn(copyBehind(from, to));
+  scheduler.run();
+
+  target.rewind();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(target.read(), i);
+    target.moveRight();
+  }
+
+  // Запись каждого элемента идёт во время чтения следующего, и ждать
+  // после чтения остаётся только запись последнего.
+  EXPECT_EQ(scheduler.now() - start, 20 + 10 * (5 + 1) - 1 + (3 + 1));
+  EXPECT_EQ(to.getBusyUntil(), scheduler.now());
+}
@@ -1,7 +1,9 @@
 #include "../include/entities/fileTapes/BinaryFileTape.h"
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -168,3 +170,138 @@ TEST_F(BinaryFileTapeTest, MoveBeyondBoundsDoesNothing) {
   tape.moveRight();
   ASSERT_TRUE(tape.isAtEnd());
 }
+
+TEST_F(BinaryFileTapeTest, SparseTapeOfTenBillionElements) {
+#ifdef _WIN32
+  GTEST_SKIP() << "Sparse files are not created by resize_file on Windows";
+#endif
+
+  const std::string filename = tmpDir + "/testSparse.bin";
+  const size_t elements = 10'000'000'000ULL;
+  const size_t bytes = elements * sizeof(int);
+
+  {
+    std::ofstream file(filename, std::ios::binary);
+    int first = 17;
+    file.write(reinterpret_cast<const char *>(&first), sizeof(int));
+  }
+
+  std::error_code error;
+  fs::resize_file(filename, bytes, error);
+  if (error) {
+    GTEST_SKIP() << "Filesystem does not support large sparse files";
+  }
+
+  {
+    std::fstream file(filename,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    int last = -42;
+    file.seekp(static_cast<std::streamoff>(bytes - sizeof(int)));
+    file.write(reinterpret_cast<const char *>(&last), sizeof(int));
+  }
+
+  BinaryFileTape tape(filename, bytes, config);
+
+  ASSERT_EQ(tape.getSize(), elements);
+  ASSERT_EQ(tape.getMaxSize(), elements);
+  ASSERT_FALSE(tape.isAtEnd());
+  ASSERT_EQ(tape.read(), 17);
+
+  tape.moveRight();
+  ASSERT_EQ(tape.read(), 0);
+
+  ASSERT_THROW(BinaryFileTape(filename, bytes - sizeof(int), config),
+               std::runtime_error);
+}
+
+TEST_F(BinaryFileTapeTest, CopyFromMovesBothHeads) {
+  TapeConfig fast{0, 0, 0, 0};
+  BinaryFileTape source(tmpDir + "/copySource.bin", 40, fast);
+  BinaryFileTape target(tmpDir + "/copyTarget.bin", 40, fast);
+
+  for (int i = 0; i < 10; ++i) {
+    source.write(i);
+    source.moveRight();
+  }
+
+  target.write(-1);
+  target.moveRight();
+  target.write(-2);
+  target.moveRight();
+
+  source.rewind();
+  for (int i = 0; i < 3; ++i)
+    source.moveRight();
+
+  target.copyFrom(source, 5);
+
+  EXPECT_EQ(source.read(), 8);
+  EXPECT_EQ(target.getSize(), 7u);
+  EXPECT_TRUE(target.isAtEnd());
+
+  target.rewind();
+  std::vector<int> copied;
+  while (!target.isAtEnd()) {
+    copied.push_back(target.read());
+    target.moveRight();
+  }
+
+  EXPECT_EQ(copied, (std::vector<int>{-1, -2, 3, 4, 5, 6, 7}));
+  EXPECT_THROW(target.copyFrom(source, 3), std::out_of_range);
+}
+
+TEST_F(BinaryFileTapeTest, CopyFromWholeFileAccountsDelays) {
+  BinaryFileTape source(tmpDir + "/copyWhole.bin", 400, TapeConfig{});
+
+  for (int i = 0; i < 100; ++i) {
+    source.write(i * 3);
+    source.moveRight();
+  }
+
+  source.rewind();
+  source.flush();
+
+  // Задержки ленты source: чтение и сдвиг по 1 мс на элемент.
+  BinaryFileTape delayed(tmpDir + "/copyWhole.bin", 400,
+                         TapeConfig{1, 0, 0, 1});
+  BinaryFileTape target(tmpDir + "/copyWholeTarget.bin", 400, TapeConfig{});
+
+  const auto start = std::chrono::steady_clock::now();
+  target.copyFrom(delayed, 100);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+  EXPECT_EQ(target.getSize(), 100u);
+
+  target.rewind();
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(target.read(), i * 3);
+    target.moveRight();
+  }
+}
+
+TEST_F(BinaryFileTapeTest, WritesReachFileAtSyncPoints) {
+  for (const Durability durability :
+       {Durability::None, Durability::Flush, Durability::Fsync}) {
+    const std::string filename = tmpDir + "/durability.bin";
+    fs::remove(filename);
+
+    {
+      BinaryFileTape tape(filename, 400, TapeConfig{}, durability);
+
+      for (int i = 0; i < 10; ++i) {
+        tape.write(i);
+        tape.moveRight();
+      }
+
+      // Записи копятся в буфере потока, а не сбрасываются поодиночке.
+      EXPECT_EQ(fs::file_size(filename), 0u);
+
+      tape.sync();
+      EXPECT_EQ(fs::file_size(filename),
+                durability == Durability::None ? 0u : 10 * sizeof(int));
+    }
+
+    EXPECT_EQ(fs::file_size(filename), 10 * sizeof(int));
+  }
+}
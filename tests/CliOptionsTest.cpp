@@ -0,0 +1,249 @@
+#include "../include/utils/cliOptions.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+TEST(CliOptionsTest, PositionalArguments) {
+  const char *argv[] = {"TapeSorter", "in.bin", "out.bin", "config.cfg"};
+  auto options = utils::parseArguments(4, argv);
+
+  EXPECT_EQ(options.mode, utils::SortMode::Sort);
+  EXPECT_EQ(options.inputFile, "in.bin");
+  EXPECT_EQ(options.outputFile, "out.bin");
+  EXPECT_EQ(options.configFile, "config.cfg");
+}
+
+TEST(CliOptionsTest, TopKOption) {
+  const char *argv[] = {"TapeSorter", "--top-k", "25", "in.bin", "out.bin"};
+  auto options = utils::parseArguments(5, argv);
+
+  EXPECT_EQ(options.mode, utils::SortMode::TopK);
+  EXPECT_EQ(options.topK, 25u);
+  EXPECT_EQ(options.inputFile, "in.bin");
+  EXPECT_TRUE(options.configFile.empty());
+}
+
+TEST(CliOptionsTest, InvalidArguments) {
+  const char *missing[] = {"TapeSorter", "in.bin"};
+  EXPECT_THROW(utils::parseArguments(2, missing), std::invalid_argument);
+
+  const char *badCount[] = {"TapeSorter", "in.bin", "out.bin", "--top-k",
+                            "-3"};
+  EXPECT_THROW(utils::parseArguments(5, badCount), std::invalid_argument);
+
+  const char *unknown[] = {"TapeSorter", "in.bin", "out.bin", "--fast"};
+  EXPECT_THROW(utils::parseArguments(4, unknown), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, MergeMode) {
+  const char *argv[] = {"TapeSorter", "--merge",  "--config", "c.cfg",
+                        "out.bin",    "a.bin",    "b.bin",    "c.bin",
+                        "--assume-sorted"};
+  auto options = utils::parseArguments(9, argv);
+
+  EXPECT_EQ(options.mode, utils::SortMode::Merge);
+  EXPECT_TRUE(options.assumeSorted);
+  EXPECT_EQ(options.configFile, "c.cfg");
+  EXPECT_EQ(options.outputFile, "out.bin");
+  EXPECT_EQ(options.mergeInputs,
+            (std::vector<std::string>{"a.bin", "b.bin", "c.bin"}));
+}
+
+TEST(CliOptionsTest, MergeModeRequiresInput) {
+  const char *argv[] = {"TapeSorter", "--merge", "out.bin"};
+  EXPECT_THROW(utils::parseArguments(3, argv), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, SampleSortMode) {
+  const char *argv[] = {"TapeSorter", "in.bin", "out.bin", "--partitions", "4",
+                        "--keep-partitions"};
+  auto options = utils::parseArguments(6, argv);
+
+  EXPECT_EQ(options.mode, utils::SortMode::SampleSort);
+  EXPECT_EQ(options.partitions, 4u);
+  EXPECT_TRUE(options.keepPartitions);
+
+  const char *traced[] = {"TapeSorter", "in.bin",  "out.bin",    "--partitions",
+                          "2",          "--trace", "sort.trace", "--stats"};
+  EXPECT_EQ(utils::parseArguments(8, traced).traceFile, "sort.trace");
+
+  const char *zero[] = {"TapeSorter", "in.bin", "out.bin", "--partitions",
+                        "0"};
+  EXPECT_THROW(utils::parseArguments(5, zero), std::invalid_argument);
+
+  const char *orphan[] = {"TapeSorter", "in.bin", "out.bin",
+                          "--keep-partitions"};
+  EXPECT_THROW(utils::parseArguments(4, orphan), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, MergeStrategyOption) {
+  const char *argv[] = {"TapeSorter", "in.bin", "out.bin", "--merge-strategy",
+                        "backward", "--stats"};
+  auto options = utils::parseArguments(6, argv);
+
+  EXPECT_EQ(options.mergeStrategy, MergeStrategy::ReadBackward);
+  EXPECT_TRUE(options.printStats);
+
+  const char *async[] = {"TapeSorter", "in.bin", "out.bin", "--merge-strategy",
+                         "async"};
+  EXPECT_EQ(utils::parseArguments(5, async).mergeStrategy,
+            MergeStrategy::Async);
+
+  const char *forecast[] = {"TapeSorter", "in.bin", "out.bin",
+                            "--merge-strategy", "forecast"};
+  EXPECT_EQ(utils::parseArguments(5, forecast).mergeStrategy,
+            MergeStrategy::Forecast);
+
+  const char *bad[] = {"TapeSorter", "in.bin", "out.bin", "--merge-strategy",
+                       "sideways"};
+  EXPECT_THROW(utils::parseArguments(5, bad), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, DaemonMode) {
+  const char *argv[] = {"TapeSorter",        "--daemon", "spool",
+                        "--workers",         "4",        "--memory-budget",
+                        "4096",              "--once",   "d.cfg",
+                        "--temp-disk-budget", "100"};
+  auto options = utils::parseArguments(11, argv);
+
+  EXPECT_EQ(options.mode, utils::SortMode::Daemon);
+  EXPECT_EQ(options.spoolDir, "spool");
+  EXPECT_EQ(options.workers, 4u);
+  EXPECT_EQ(options.memoryBudget, 4096u);
+  EXPECT_EQ(options.tempDiskBudget, 100u);
+  EXPECT_TRUE(options.once);
+  EXPECT_EQ(options.configFile, "d.cfg");
+}
+
+TEST(CliOptionsTest, DaemonOptionsRequireDaemon) {
+  const char *argv[] = {"TapeSorter", "in.bin", "out.bin", "--workers", "2"};
+  EXPECT_THROW(utils::parseArguments(5, argv), std::invalid_argument);
+
+  const char *noWorkers[] = {"TapeSorter", "--daemon", "spool", "--workers",
+                             "0"};
+  EXPECT_THROW(utils::parseArguments(5, noWorkers), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, MergeThreadsOption) {
+  const char *argv[] = {"TapeSorter", "in.bin", "out.bin", "--merge-threads",
+                        "4"};
+  EXPECT_EQ(utils::parseArguments(5, argv).mergeThreads, 4u);
+
+  const char *zero[] = {"TapeSorter", "in.bin", "out.bin", "--merge-threads",
+                        "0"};
+  EXPECT_THROW(utils::parseArguments(5, zero), std::invalid_argument);
+
+  const char *partitions[] = {"TapeSorter",      "in.bin", "out.bin",
+                              "--merge-threads", "2",      "--partitions",
+                              "2"};
+  EXPECT_THROW(utils::parseArguments(7, partitions), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, IndexOption) {
+  const char *argv[] = {"TapeSorter", "in.bin", "out.bin", "--index", "256"};
+  EXPECT_EQ(utils::parseArguments(5, argv).indexBlock, 256u);
+
+  const char *zero[] = {"TapeSorter", "in.bin", "out.bin", "--index", "0"};
+  EXPECT_THROW(utils::parseArguments(5, zero), std::invalid_argument);
+
+  const char *keep[] = {"TapeSorter",   "in.bin", "out.bin",
+                        "--partitions", "2",      "--keep-partitions",
+                        "--index",      "4"};
+  EXPECT_THROW(utils::parseArguments(8, keep), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, LookupMode) {
+  const char *argv[] = {"TapeSorter", "--lookup", "out.bin", "-5", "7"};
+  const auto options = utils::parseArguments(5, argv);
+
+  EXPECT_EQ(options.mode, utils::SortMode::Lookup);
+  EXPECT_EQ(options.lookupFile, "out.bin");
+  EXPECT_EQ(options.lookupLo, -5);
+  EXPECT_EQ(options.lookupHi, 7);
+
+  const char *point[] = {"TapeSorter", "--lookup", "out.bin", "3"};
+  EXPECT_EQ(utils::parseArguments(4, point).lookupHi, 3);
+
+  const char *noKey[] = {"TapeSorter", "--lookup", "out.bin"};
+  EXPECT_THROW(utils::parseArguments(3, noKey), std::invalid_argument);
+
+  const char *badKey[] = {"TapeSorter", "--lookup", "out.bin", "3000000000"};
+  EXPECT_THROW(utils::parseArguments(4, badKey), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, SketchOptions) {
+  const char *sort[] = {"TapeSorter", "in.bin", "out.bin", "--sketch", "32"};
+  const auto options = utils::parseArguments(5, sort);
+
+  EXPECT_EQ(options.mode, utils::SortMode::Sort);
+  EXPECT_EQ(options.sketchBins, 32u);
+
+  const char *only[] = {"TapeSorter", "--sketch-only", "in.bin", "cfg.txt"};
+  const auto sketch = utils::parseArguments(4, only);
+
+  EXPECT_EQ(sketch.mode, utils::SortMode::Sketch);
+  EXPECT_EQ(sketch.inputFile, "in.bin");
+  EXPECT_EQ(sketch.configFile, "cfg.txt");
+  EXPECT_EQ(sketch.sketchBins, utils::kDefaultSketchBins);
+
+  const char *zero[] = {"TapeSorter", "in.bin", "out.bin", "--sketch", "1"};
+  EXPECT_THROW(utils::parseArguments(5, zero), std::invalid_argument);
+
+  const char *merge[] = {"TapeSorter", "--merge", "--sketch", "8",
+                         "out.bin",    "a.bin",   "b.bin"};
+  EXPECT_THROW(utils::parseArguments(7, merge), std::invalid_argument);
+
+  const char *noInput[] = {"TapeSorter", "--sketch-only"};
+  EXPECT_THROW(utils::parseArguments(2, noInput), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, VerifyOptions) {
+  const char *sort[] = {"TapeSorter", "in.bin", "out.bin", "--verify"};
+  const auto options = utils::parseArguments(4, sort);
+
+  EXPECT_EQ(options.mode, utils::SortMode::Sort);
+  EXPECT_TRUE(options.verify);
+
+  const char *only[] = {"TapeSorter", "--verify-only", "out.bin", "in.bin",
+                        "--config",   "cfg.txt"};
+  const auto verify = utils::parseArguments(6, only);
+
+  EXPECT_EQ(verify.mode, utils::SortMode::Verify);
+  EXPECT_EQ(verify.outputFile, "out.bin");
+  EXPECT_EQ(verify.inputFile, "in.bin");
+  EXPECT_EQ(verify.configFile, "cfg.txt");
+
+  const char *topK[] = {"TapeSorter", "in.bin",  "out.bin",
+                        "--top-k",    "5",       "--verify"};
+  EXPECT_THROW(utils::parseArguments(6, topK), std::invalid_argument);
+
+  const char *noFile[] = {"TapeSorter", "--verify-only"};
+  EXPECT_THROW(utils::parseArguments(2, noFile), std::invalid_argument);
+}
+
+TEST(CliOptionsTest, OrderOptions) {
+  const char *sort[] = {"TapeSorter", "in.bin", "out.bin",
+                        "--order",    "abs",    "--stable"};
+  const auto options = utils::parseArguments(6, sort);
+
+  EXPECT_EQ(options.order, utils::OrderOption::Magnitude);
+  EXPECT_TRUE(options.stable);
+
+  const char *merge[] = {"TapeSorter", "--merge", "--order", "desc",
+                         "out.bin",    "a.bin",   "b.bin"};
+  EXPECT_EQ(utils::parseArguments(7, merge).order,
+            utils::OrderOption::Descending);
+
+  const char *unknown[] = {"TapeSorter", "in.bin", "out.bin", "--order",
+                           "random"};
+  EXPECT_THROW(utils::parseArguments(5, unknown), std::invalid_argument);
+
+  const char *index[] = {"TapeSorter", "in.bin", "out.bin", "--order",
+                         "desc",       "--index", "64"};
+  EXPECT_THROW(utils::parseArguments(7, index), std::invalid_argument);
+
+  const char *partitions[] = {"TapeSorter", "in.bin",       "out.bin",
+                              "--stable",   "--partitions", "2"};
+  EXPECT_THROW(utils::parseArguments(6, partitions), std::invalid_argument);
+}
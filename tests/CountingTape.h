@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../include/interfaces/TapeInterface.h"
+
+#include <cstddef>
+
+/// @brief Считает операции ленты, не забирая её во владение.
+class CountingTape : public TapeInterface {
+public:
+  explicit CountingTape(TapeInterface &tape) : m_tape(tape) {}
+
+  int read() override {
+    ++reads;
+    return m_tape.read();
+  }
+
+  void write(int data) override {
+    ++writes;
+    m_tape.write(data);
+  }
+
+  void moveLeft() override {
+    ++leftShifts;
+    m_tape.moveLeft();
+  }
+
+  void moveRight() override {
+    ++rightShifts;
+    m_tape.moveRight();
+  }
+
+  void rewind() override {
+    ++rewinds;
+    m_tape.rewind();
+  }
+
+  bool isAtEnd() const override { return m_tape.isAtEnd(); }
+
+  size_t getSize() const override { return m_tape.getSize(); }
+
+  void sync() override { m_tape.sync(); }
+
+  size_t reads = 0;
+  size_t writes = 0;
+  size_t leftShifts = 0;
+  size_t rightShifts = 0;
+  size_t rewinds = 0;
+
+private:
+  TapeInterface &m_tape;
+};
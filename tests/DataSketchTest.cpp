@@ -0,0 +1,232 @@
+#include "../include/entities/DataSketch.h"
+#include "../include/entities/TapeSorter.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+#include "CountingTape.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::vector<int> randomValues(size_t count, int lo, int hi, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(lo, hi);
+
+  std::vector<int> values(count);
+  for (int &value : values) {
+    value = dist(gen);
+  }
+
+  return values;
+}
+
+/// @brief Наибольшее отклонение приближённого ранга квантилей от точного,
+/// в долях от числа элементов.
+double maxRankError(const KllSketch &sketch, std::vector<int> values) {
+  std::sort(values.begin(), values.end());
+
+  double worst = 0;
+
+  for (int percent = 1; percent < 100; ++percent) {
+    const int estimate = sketch.quantile(percent / 100.0);
+    const auto rank =
+        std::upper_bound(values.begin(), values.end(), estimate) -
+        values.begin();
+    const double error = std::abs(static_cast<double>(rank) / values.size() -
+                                  percent / 100.0);
+
+    worst = std::max(worst, error);
+  }
+
+  return worst;
+}
+
+} // namespace
+
+class DataSketchTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  std::unique_ptr<BinaryFileTape> makeTape(const std::string &name,
+                                           const std::vector<int> &data) {
+    auto tape = std::make_unique<BinaryFileTape>(
+        tempDir + "/" + name, data.size() * sizeof(int), cfg);
+
+    for (int value : data) {
+      tape->write(value);
+      tape->moveRight();
+    }
+
+    tape->rewind();
+    return tape;
+  }
+
+  const std::string tempDir = "data_sketch_test_tmp";
+  const TapeConfig cfg{0, 0, 0, 0};
+};
+
+TEST_F(DataSketchTest, KllQuantilesWithinRankError) {
+  const auto values = randomValues(100000, -1000000, 1000000, 7);
+
+  KllSketch sketch;
+  for (int value : values) {
+    sketch.add(value);
+  }
+
+  EXPECT_EQ(sketch.getCount(), values.size());
+  EXPECT_EQ(sketch.getMin(), *std::min_element(values.begin(), values.end()));
+  EXPECT_EQ(sketch.getMax(), *std::max_element(values.begin(), values.end()));
+
+  EXPECT_LT(sketch.getRetained(), 1000u);
+  EXPECT_LT(maxRankError(sketch, values), 0.02);
+}
+
+TEST_F(DataSketchTest, KllSortedInputAndRank) {
+  std::vector<int> values(50000);
+  std::iota(values.begin(), values.end(), 0);
+
+  KllSketch sketch(100, 3);
+  for (int value : values) {
+    sketch.add(value);
+  }
+
+  EXPECT_LT(maxRankError(sketch, values), 0.04);
+
+  const double rank = static_cast<double>(sketch.rank(25000));
+  EXPECT_NEAR(rank / values.size(), 0.5, 0.04);
+}
+
+TEST_F(DataSketchTest, KllSmallInputIsExact) {
+  KllSketch sketch;
+
+  EXPECT_THROW(sketch.quantile(0.5), std::logic_error);
+
+  for (int value : {5, 1, 4, 2, 3}) {
+    sketch.add(value);
+  }
+
+  EXPECT_EQ(sketch.getRetained(), 5u);
+  EXPECT_EQ(sketch.quantile(0), 1);
+  EXPECT_EQ(sketch.quantile(0.5), 3);
+  EXPECT_EQ(sketch.quantile(1), 5);
+  EXPECT_EQ(sketch.rank(2), 2u);
+}
+
+TEST_F(DataSketchTest, HistogramCountsAreExact) {
+  const auto values = randomValues(20000, -5000, 3000, 11);
+
+  EquiWidthHistogram histogram(8);
+  for (int value : values) {
+    histogram.add(value);
+  }
+
+  const auto &counts = histogram.getCounts();
+  ASSERT_EQ(counts.size(), 8u);
+
+  const int64_t low = histogram.getLow();
+  const int64_t width = histogram.getWidth();
+
+  EXPECT_EQ(low % width, 0);
+
+  for (size_t i = 0; i < counts.size(); ++i) {
+    const int64_t from = low + static_cast<int64_t>(i) * width;
+
+    const auto expected = std::count_if(
+        values.begin(), values.end(),
+        [&](int value) { return value >= from && value < from + width; });
+
+    EXPECT_EQ(counts[i], static_cast<size_t>(expected)) << "bin " << i;
+  }
+
+  // Диапазон покрыт не более чем вдвое шире нужного.
+  EXPECT_LE(width * 8, 2 * (3000 + 5000 + 1) + 2 * width);
+}
+
+TEST_F(DataSketchTest, HistogramAcrossZeroAndWeights) {
+  EquiWidthHistogram histogram(2);
+
+  histogram.add(10);
+  histogram.add(-3, 4);
+
+  EXPECT_EQ(histogram.getLow(), -16);
+  EXPECT_EQ(histogram.getWidth(), 16);
+  EXPECT_EQ(histogram.getCounts(), (std::vector<size_t>{4, 1}));
+
+  EXPECT_THROW(EquiWidthHistogram(1), std::invalid_argument);
+}
+
+TEST_F(DataSketchTest, SortCollectsSketch) {
+  const auto values = randomValues(3000, -100000, 100000, 5);
+  auto input = makeTape("input.bin", values);
+  BinaryFileTape output(tempDir + "/output.bin",
+                        values.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(256, cfg, tempDir + "/tmp");
+  sorter.sort(*input, output);
+  EXPECT_FALSE(sorter.getStats().sketch);
+
+  sorter.setSketch(10);
+  sorter.sort(*input, output);
+
+  const auto &sketch = sorter.getStats().sketch;
+  ASSERT_TRUE(sketch);
+  EXPECT_FALSE(sorter.getStats().countingSort);
+  EXPECT_EQ(sketch->quantiles.getCount(), values.size());
+  EXPECT_LT(maxRankError(sketch->quantiles, values), 0.03);
+
+  const auto &counts = sketch->histogram.getCounts();
+  EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), size_t{0}),
+            values.size());
+}
+
+TEST_F(DataSketchTest, CountingSortFeedsSketchOnce) {
+  std::vector<int> values(500);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i % 4);
+  }
+
+  auto input = makeTape("input.bin", values);
+  BinaryFileTape output(tempDir + "/output.bin",
+                        values.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(256, cfg, tempDir + "/tmp");
+  sorter.setSketch(4);
+  sorter.sort(*input, output);
+
+  ASSERT_TRUE(sorter.getStats().countingSort);
+
+  const auto &sketch = sorter.getStats().sketch;
+  ASSERT_TRUE(sketch);
+  EXPECT_EQ(sketch->quantiles.getCount(), values.size());
+  EXPECT_EQ(sketch->quantiles.quantile(0.5), 1);
+  EXPECT_EQ(sketch->histogram.getCounts(),
+            (std::vector<size_t>{125, 125, 125, 125}));
+}
+
+TEST_F(DataSketchTest, SketchOnlyReadsOnceWithoutWrites) {
+  const auto values = randomValues(2000, 0, 999, 9);
+  auto file = makeTape("input.bin", values);
+  CountingTape input(*file);
+
+  TapeSorter sorter(256, cfg, tempDir + "/tmp");
+  const DataSketch sketch = sorter.sketch(input, 5);
+
+  EXPECT_EQ(input.reads, values.size());
+  EXPECT_EQ(input.rewinds, 1u);
+  EXPECT_EQ(input.writes, 0u);
+  EXPECT_FALSE(fs::exists(tempDir + "/tmp"));
+
+  EXPECT_EQ(sketch.quantiles.getCount(), values.size());
+  EXPECT_EQ(sketch.histogram.getCounts().size(), 5u);
+}
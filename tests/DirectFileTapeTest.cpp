@@ -0,0 +1,124 @@
+#include "../include/entities/fileTapes/DirectFileTape.h"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+class DirectFileTapeTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    if (!DirectFileTape::isSupported()) {
+      GTEST_SKIP() << "DirectFileTape is not supported on this platform";
+    }
+
+    fs::create_directory(tmpDir);
+  }
+
+  void TearDown() override { fs::remove_all(tmpDir); }
+
+  const std::string tmpDir = "testTempDirectFileTapeTest";
+
+  TapeConfig config{0, 0, 0, 0};
+};
+
+TEST_F(DirectFileTapeTest, WriteAndRead) {
+  const std::string filename = tmpDir + "/testWriteAndRead.bin";
+
+  DirectFileTape tape(filename, 40, config);
+
+  tape.write(123);
+  tape.moveRight();
+  tape.write(-7);
+  tape.rewind();
+
+  ASSERT_EQ(tape.read(), 123);
+  tape.moveRight();
+  ASSERT_EQ(tape.read(), -7);
+  ASSERT_EQ(tape.getSize(), 2);
+
+  tape.moveLeft();
+  ASSERT_EQ(tape.read(), 123);
+}
+
+TEST_F(DirectFileTapeTest, ReadFromExistingFile) {
+  const std::string filename = tmpDir + "/testExisting.bin";
+
+  {
+    std::ofstream file(filename, std::ios::binary);
+    int data[] = {10, 20, 30};
+    file.write(reinterpret_cast<const char *>(data), sizeof(data));
+  }
+
+  DirectFileTape tape(filename, 40, config);
+  ASSERT_EQ(tape.getSize(), 3);
+
+  ASSERT_EQ(tape.read(), 10);
+  tape.moveRight();
+  ASSERT_EQ(tape.read(), 20);
+  tape.moveRight();
+  ASSERT_EQ(tape.read(), 30);
+  tape.moveRight();
+  ASSERT_TRUE(tape.isAtEnd());
+  ASSERT_THROW(tape.read(), std::out_of_range);
+}
+
+TEST_F(DirectFileTapeTest, SpansBlocksAndTruncatesOnClose) {
+  const std::string filename = tmpDir + "/testBlocks.bin";
+  const int count = 50000;
+
+  {
+    DirectFileTape tape(filename, count * sizeof(int), config);
+
+    for (int i = 0; i < count; ++i) {
+      tape.write(i * 3);
+      tape.moveRight();
+    }
+
+    ASSERT_THROW(tape.write(0), std::out_of_range);
+  }
+
+  ASSERT_EQ(fs::file_size(filename), count * sizeof(int));
+
+  std::ifstream file(filename, std::ios::binary);
+  std::vector<int> data(count);
+  file.read(reinterpret_cast<char *>(data.data()), count * sizeof(int));
+
+  for (int i = 0; i < count; ++i) {
+    ASSERT_EQ(data[i], i * 3);
+  }
+}
+
+TEST_F(DirectFileTapeTest, SizeLimitOnOpen) {
+  const std::string filename = tmpDir + "/testLimit.bin";
+
+  {
+    std::ofstream file(filename, std::ios::binary);
+    int data[] = {1, 2, 3};
+    file.write(reinterpret_cast<const char *>(data), sizeof(data));
+  }
+
+  EXPECT_THROW(DirectFileTape(filename, 8, config), std::runtime_error);
+}
+
+TEST_F(DirectFileTapeTest, SparseTapeBeyondFourGigabytes) {
+  const std::string filename = tmpDir + "/testSparse.bin";
+  const size_t elements = (size_t{3} << 30) + 5;
+  const size_t bytes = elements * sizeof(int);
+
+  std::ofstream(filename, std::ios::binary).close();
+
+  std::error_code error;
+  fs::resize_file(filename, bytes, error);
+  if (error) {
+    GTEST_SKIP() << "Filesystem does not support large sparse files";
+  }
+
+  DirectFileTape tape(filename, bytes, config);
+
+  ASSERT_EQ(tape.getSize(), elements);
+  ASSERT_EQ(tape.read(), 0);
+}
@@ -0,0 +1,73 @@
+#include "../include/entities/DrivePlanner.h"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+TEST(DrivePlannerTest, RequiresDrives) {
+  EXPECT_THROW(DrivePlanner({}), std::invalid_argument);
+}
+
+TEST(DrivePlannerTest, PlacesRunsOnFasterDrive) {
+  DrivePlanner planner({DriveConfig{1, 1, 0, 0}, DriveConfig{4, 4, 0, 0}});
+
+  size_t onFast = 0;
+  for (int i = 0; i < 10; ++i) {
+    if (planner.placeRun(100) == 0)
+      ++onFast;
+  }
+
+  // Быстрый привод пишет серию в четыре раза быстрее, поэтому получает
+  // примерно 4/5 серий.
+  EXPECT_EQ(onFast, 8u);
+}
+
+TEST(DrivePlannerTest, StepsNeverReadAndWriteSameDrive) {
+  DrivePlanner planner({DriveConfig{1, 1, 0, 1}, DriveConfig{1, 1, 0, 1},
+                        DriveConfig{2, 2, 0, 1}, DriveConfig{3, 3, 0, 1}});
+
+  std::vector<PlacedRun> runs;
+  for (int i = 0; i < 11; ++i) {
+    runs.push_back({planner.placeRun(50), 50});
+  }
+
+  const auto steps = planner.planLevel(runs);
+
+  std::multiset<size_t> used;
+  for (const auto &step : steps) {
+    ASSERT_FALSE(step.empty());
+
+    std::set<size_t> reading;
+    std::set<size_t> writing;
+
+    for (const PlannedMerge &merge : step) {
+      reading.insert(runs[merge.first].drive);
+      reading.insert(runs[merge.second].drive);
+      writing.insert(merge.outputDrive);
+      used.insert(merge.first);
+      used.insert(merge.second);
+    }
+
+    for (size_t drive : writing) {
+      EXPECT_EQ(reading.count(drive), 0u);
+    }
+  }
+
+  // Пять слияний, одна серия переходит на следующий уровень без изменений.
+  EXPECT_EQ(used.size(), 10u);
+  EXPECT_EQ(std::set<size_t>(used.begin(), used.end()).size(), 10u);
+}
+
+TEST(DrivePlannerTest, SingleDriveMergesOneByOne) {
+  DrivePlanner planner({DriveConfig{1, 1, 1, 1}});
+
+  std::vector<PlacedRun> runs(6, PlacedRun{0, 10});
+  const auto steps = planner.planLevel(runs);
+
+  ASSERT_EQ(steps.size(), 3u);
+  for (const auto &step : steps) {
+    ASSERT_EQ(step.size(), 1u);
+    EXPECT_EQ(step[0].outputDrive, 0u);
+  }
+}
@@ -0,0 +1,100 @@
+#include "../include/entities/ForecastingMerger.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class ForecastingMergerTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  std::unique_ptr<BinaryFileTape> makeTape(const std::string &name,
+                                           const std::vector<int> &data) {
+    auto tape = std::make_unique<BinaryFileTape>(
+        tempDir + "/" + name, data.size() * sizeof(int), TapeConfig{});
+
+    for (int value : data) {
+      tape->write(value);
+      tape->moveRight();
+    }
+
+    tape->rewind();
+    return tape;
+  }
+
+  const std::string tempDir = "forecasting_merger_test_tmp";
+};
+
+TEST_F(ForecastingMergerTest, RejectsEmptyBlocks) {
+  EXPECT_THROW(ForecastingMerger({}, 0), std::invalid_argument);
+}
+
+TEST_F(ForecastingMergerTest, ForecastNeverMisses) {
+  std::mt19937 rng(5);
+  // Узкий диапазон даёт много равных ключей на границах блоков.
+  std::uniform_int_distribution<int> dist(0, 40);
+  std::uniform_int_distribution<size_t> length(0, 300);
+
+  std::vector<std::unique_ptr<BinaryFileTape>> tapes;
+  std::vector<TapeInterface *> inputs;
+  std::vector<int> expected;
+
+  for (int i = 0; i < 9; ++i) {
+    std::vector<int> run(length(rng));
+    for (auto &v : run)
+      v = dist(rng);
+    std::sort(run.begin(), run.end());
+
+    expected.insert(expected.end(), run.begin(), run.end());
+    tapes.push_back(makeTape("run_" + std::to_string(i) + ".bin", run));
+    inputs.push_back(tapes.back().get());
+  }
+
+  std::sort(expected.begin(), expected.end());
+
+  BinaryFileTape result(tempDir + "/result.bin", expected.size() * sizeof(int),
+                        TapeConfig{});
+
+  ForecastingMerger merger(inputs, 7);
+  merger.merge(result);
+
+  std::vector<int> merged;
+  result.rewind();
+  for (size_t i = 0; i < result.getSize(); ++i) {
+    merged.push_back(result.read());
+    result.moveRight();
+  }
+
+  EXPECT_EQ(merged, expected);
+  EXPECT_GT(merger.getPrefetched(), 0u);
+  EXPECT_EQ(merger.getMisses(), 0u);
+}
+
+TEST_F(ForecastingMergerTest, StopsAtLimit) {
+  auto first = makeTape("first.bin", {1, 4, 7, 10});
+  auto second = makeTape("second.bin", {2, 3, 8});
+  BinaryFileTape result(tempDir + "/limited.bin", 4 * sizeof(int),
+                        TapeConfig{});
+
+  ForecastingMerger merger({first.get(), second.get()}, 1);
+  merger.merge(result, 4);
+
+  std::vector<int> merged;
+  result.rewind();
+  for (size_t i = 0; i < result.getSize(); ++i) {
+    merged.push_back(result.read());
+    result.moveRight();
+  }
+
+  EXPECT_EQ(merged, (std::vector<int>{1, 2, 3, 4}));
+}
@@ -0,0 +1,182 @@
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/entities/TapeSorter.h"
+#include "../include/entities/TapeView.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+#include "../include/index/IndexingTape.h"
+#include "../include/index/SparseIndex.h"
+#include "../include/index/TapeSearch.h"
+
+namespace fs = std::filesystem;
+
+class IndexTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    fs::create_directories(tempDir);
+    tape = std::make_unique<BinaryFileTape>(tapeFile, 1024 * sizeof(int), cfg);
+  }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  /// @brief Пишет values на ленту через IndexingTape и сохраняет индекс.
+  SparseIndex writeIndexed(const std::vector<int> &values,
+                           size_t blockElements) {
+    IndexingTape indexing(std::make_unique<TapeView>(*tape), indexFile,
+                          blockElements);
+
+    for (int value : values) {
+      indexing.write(value);
+      indexing.moveRight();
+    }
+
+    indexing.sync();
+    return indexing.getIndex();
+  }
+
+  const std::string tempDir = "index_test_tmp";
+  const std::string tapeFile = tempDir + "/sorted.bin";
+  const std::string indexFile = SparseIndex::sidecarFor(tapeFile);
+
+  TapeConfig cfg{0, 0, 0, 0};
+  std::unique_ptr<BinaryFileTape> tape;
+};
+
+TEST_F(IndexTest, BlocksHoldMinKeyAndOffset) {
+  const SparseIndex index = writeIndexed({1, 2, 2, 5, 7, 7, 7, 9}, 3);
+
+  ASSERT_EQ(index.getBlocks().size(), 3u);
+  EXPECT_EQ(index.getElements(), 8u);
+
+  EXPECT_EQ(index.getBlocks()[0].minKey, 1);
+  EXPECT_EQ(index.getBlocks()[1].minKey, 5);
+  EXPECT_EQ(index.getBlocks()[2].minKey, 7);
+  EXPECT_EQ(index.getBlocks()[2].offset, 6u);
+
+  // Семёрки начинаются в блоке 1, хотя блок 2 тоже начинается с 7.
+  EXPECT_EQ(index.findBlock(7), 1u);
+  EXPECT_EQ(index.findBlock(0), 0u);
+  EXPECT_EQ(index.findBlock(100), 2u);
+}
+
+TEST_F(IndexTest, SidecarRoundTrip) {
+  writeIndexed({-3, 0, 4, 8, 15}, 2);
+
+  const SparseIndex loaded = SparseIndex::load(indexFile);
+
+  EXPECT_EQ(loaded.getBlockElements(), 2u);
+  EXPECT_EQ(loaded.getElements(), 5u);
+  ASSERT_EQ(loaded.getBlocks().size(), 3u);
+  EXPECT_EQ(loaded.getBlocks()[1].minKey, 4);
+  EXPECT_EQ(loaded.getBlocks()[1].offset, 2u);
+
+  fs::resize_file(indexFile, fs::file_size(indexFile) - 1);
+  EXPECT_THROW(SparseIndex::load(indexFile), std::runtime_error);
+  EXPECT_THROW(SparseIndex::load(tapeFile), std::runtime_error);
+}
+
+TEST_F(IndexTest, SortEmitsIndexOfOutput) {
+  BinaryFileTape input(tempDir + "/input.bin", 1000 * sizeof(int), cfg);
+
+  for (int i = 0; i < 1000; ++i) {
+    input.write((i * 7919) % 1000);
+    input.moveRight();
+  }
+
+  {
+    IndexingTape output(std::make_unique<TapeView>(*tape), indexFile, 100);
+    TapeSorter sorter(64 * sizeof(int), cfg, tempDir + "/tmp");
+    sorter.sort(input, output);
+  }
+
+  const SparseIndex index = SparseIndex::load(indexFile);
+
+  ASSERT_EQ(index.getBlocks().size(), 10u);
+  for (size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(index.getBlocks()[i].minKey, static_cast<int>(i * 100));
+  }
+}
+
+TEST_F(IndexTest, FindReadsOneBlock) {
+  std::vector<int> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(i * 2);
+  }
+
+  TapeSearch search(*tape, writeIndexed(values, 32), cfg);
+
+  EXPECT_EQ(search.find(1000), 500u);
+  EXPECT_EQ(search.getRewinds(), 1u);
+
+  // Блок 15 начинается с 480: 480 сдвигов до него и 20 внутри блока.
+  EXPECT_EQ(search.getShifts(), 500u);
+
+  EXPECT_FALSE(search.find(1001).has_value());
+  EXPECT_FALSE(search.find(-1).has_value());
+  EXPECT_FALSE(search.find(5000).has_value());
+  EXPECT_EQ(search.find(0), 0u);
+  EXPECT_EQ(search.find(1998), 999u);
+}
+
+TEST_F(IndexTest, FindReturnsFirstOfEqualKeys) {
+  TapeSearch search(*tape, writeIndexed({1, 3, 3, 3, 3, 3, 3, 4}, 2), cfg);
+
+  EXPECT_EQ(search.find(3), 1u);
+  EXPECT_EQ(search.find(4), 7u);
+  EXPECT_FALSE(search.find(2).has_value());
+}
+
+TEST_F(IndexTest, SeekPrefersCheaperOfShiftsAndRewind) {
+  std::vector<int> values;
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+
+  const SparseIndex index = writeIndexed(values, 10);
+
+  {
+    // Перемотка дороже сорока сдвигов назад.
+    TapeSearch search(*tape, index, TapeConfig{0, 0, 1000, 1});
+    ASSERT_EQ(search.find(90), 90u);
+    ASSERT_EQ(search.find(50), 50u);
+    EXPECT_EQ(search.getRewinds(), 1u);
+  }
+
+  {
+    // Перемотка дешевле сдвигов.
+    TapeSearch search(*tape, index, TapeConfig{0, 0, 1, 10});
+    ASSERT_EQ(search.find(90), 90u);
+    ASSERT_EQ(search.find(5), 5u);
+    EXPECT_EQ(search.getRewinds(), 2u);
+    EXPECT_EQ(search.getShifts(), 95u);
+  }
+}
+
+TEST_F(IndexTest, ScanVisitsRange) {
+  TapeSearch search(*tape, writeIndexed({1, 2, 2, 5, 7, 7, 7, 9, 12}, 3),
+                    cfg);
+
+  std::vector<int> found;
+  const auto collect = [&](int value) { found.push_back(value); };
+
+  EXPECT_EQ(search.scan(2, 7, collect), 6u);
+  EXPECT_EQ(found, (std::vector<int>{2, 2, 5, 7, 7, 7}));
+
+  found.clear();
+  EXPECT_EQ(search.scan(10, 100, collect), 1u);
+  EXPECT_EQ(found, (std::vector<int>{12}));
+
+  EXPECT_EQ(search.scan(3, 4, collect), 0u);
+  EXPECT_EQ(search.scan(13, 20, collect), 0u);
+  EXPECT_EQ(search.scan(7, 2, collect), 0u);
+}
+
+TEST_F(IndexTest, IndexMustMatchTape) {
+  SparseIndex index = writeIndexed({1, 2, 3}, 2);
+  index.add(3, 4);
+
+  EXPECT_THROW(TapeSearch(*tape, index, cfg), std::runtime_error);
+}
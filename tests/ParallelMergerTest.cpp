@@ -0,0 +1,136 @@
+#include "../include/entities/ParallelMerger.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+SortedRun runOf(const std::vector<int> &data) {
+  return {data.size(), [&data](size_t index) { return data[index]; }};
+}
+
+} // namespace
+
+class ParallelMergerTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  std::string writeFile(const std::string &name,
+                        const std::vector<int> &data) {
+    const std::string path = tempDir + "/" + name;
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(data.data()),
+               static_cast<std::streamsize>(data.size() * sizeof(int)));
+    return path;
+  }
+
+  std::vector<int> readFile(const std::string &path) {
+    std::vector<int> data(fs::file_size(path) / sizeof(int));
+    std::ifstream file(path, std::ios::binary);
+    file.read(reinterpret_cast<char *>(data.data()),
+              static_cast<std::streamsize>(data.size() * sizeof(int)));
+    return data;
+  }
+
+  const std::string tempDir = "parallel_merger_test_tmp";
+};
+
+TEST_F(ParallelMergerTest, CoRankSplitsEqualKeysByRunOrder) {
+  const std::vector<int> a{1, 3, 3, 3, 8};
+  const std::vector<int> b{2, 3, 3, 9};
+  const std::vector<SortedRun> runs{runOf(a), runOf(b)};
+
+  EXPECT_EQ(ParallelMerger::coRank(runs, 0), (std::vector<size_t>{0, 0}));
+  EXPECT_EQ(ParallelMerger::coRank(runs, 3), (std::vector<size_t>{2, 1}));
+  // Равные тройки сначала берутся из первой серии.
+  EXPECT_EQ(ParallelMerger::coRank(runs, 5), (std::vector<size_t>{4, 1}));
+  EXPECT_EQ(ParallelMerger::coRank(runs, 6), (std::vector<size_t>{4, 2}));
+  EXPECT_EQ(ParallelMerger::coRank(runs, 9), (std::vector<size_t>{5, 4}));
+  EXPECT_THROW(ParallelMerger::coRank(runs, 10), std::invalid_argument);
+}
+
+TEST_F(ParallelMergerTest, MergesFilesInParallel) {
+  std::mt19937 rng(31);
+  std::uniform_int_distribution<int> dist(-50, 50);
+  std::uniform_int_distribution<size_t> length(0, 400);
+
+  std::vector<std::string> inputs;
+  std::vector<int> expected;
+
+  for (int i = 0; i < 6; ++i) {
+    std::vector<int> run(length(rng));
+    for (auto &v : run)
+      v = dist(rng);
+    std::sort(run.begin(), run.end());
+
+    expected.insert(expected.end(), run.begin(), run.end());
+    inputs.push_back(writeFile("run_" + std::to_string(i) + ".bin", run));
+  }
+
+  std::sort(expected.begin(), expected.end());
+
+  for (size_t threads : {1u, 3u, 8u}) {
+    const std::string output =
+        writeFile("out_" + std::to_string(threads) + ".bin", {});
+
+    ParallelMerger merger(inputs, threads, 16);
+    EXPECT_EQ(merger.merge(output), expected.size());
+    EXPECT_EQ(readFile(output), expected) << "threads = " << threads;
+  }
+
+  const std::string limited = writeFile("limited.bin", {});
+  EXPECT_EQ(ParallelMerger(inputs, 4, 5).merge(limited, 100), 100u);
+  EXPECT_EQ(readFile(limited),
+            std::vector<int>(expected.begin(), expected.begin() + 100));
+}
+
+TEST_F(ParallelMergerTest, MergesTwoRunsInBlocks) {
+  std::mt19937 rng(7);
+
+  for (int range : {3, 1000}) {
+    std::uniform_int_distribution<int> dist(-range, range);
+
+    std::vector<int> a(517);
+    std::vector<int> b(300);
+    for (auto &v : a)
+      v = dist(rng);
+    for (auto &v : b)
+      v = dist(rng);
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+
+    const std::vector<std::string> inputs{writeFile("a.bin", a),
+                                          writeFile("b.bin", b)};
+
+    std::vector<int> expected(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+
+    // Буферы разного размера сдвигают границы блоков и порций выхода.
+    for (size_t buffer : {1u, 3u, 16u, 1000u}) {
+      for (size_t threads : {1u, 4u}) {
+        const std::string output = writeFile("out.bin", {});
+
+        EXPECT_EQ(ParallelMerger(inputs, threads, buffer).merge(output),
+                  expected.size());
+        EXPECT_EQ(readFile(output), expected)
+            << "range = " << range << ", buffer = " << buffer
+            << ", threads = " << threads;
+      }
+    }
+
+    const std::string limited = writeFile("limited.bin", {});
+    EXPECT_EQ(ParallelMerger(inputs, 2, 8).merge(limited, 401), 401u);
+    EXPECT_EQ(readFile(limited),
+              std::vector<int>(expected.begin(), expected.begin() + 401));
+  }
+}
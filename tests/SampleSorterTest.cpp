@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "../include/entities/SampleSorter.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+#include "../include/trace/TraceRecorder.h"
+#include "../include/trace/TraceReplayer.h"
+
+namespace fs = std::filesystem;
+
+class SampleSorterTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  const std::string tempDir = "sample_sorter_test_tmp";
+
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::unique_ptr<BinaryFileTape> writeTape(const std::string &file,
+                                            const std::vector<int> &data) {
+    auto tape =
+        std::make_unique<BinaryFileTape>(file, data.size() * sizeof(int), cfg);
+
+    for (int value : data) {
+      tape->write(value);
+      tape->moveRight();
+    }
+
+    tape->rewind();
+    return tape;
+  }
+
+  static std::vector<int> readAll(TapeInterface &tape) {
+    std::vector<int> out;
+
+    tape.rewind();
+    while (!tape.isAtEnd()) {
+      out.push_back(tape.read());
+      tape.moveRight();
+    }
+
+    return out;
+  }
+
+  static std::vector<int> randomData(size_t n, int lo, int hi) {
+    std::vector<int> data(n);
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> dist(lo, hi);
+    for (auto &v : data)
+      v = dist(rng);
+
+    return data;
+  }
+};
+
+TEST_F(SampleSorterTest, SortsIntoSingleOutput) {
+  auto data = randomData(400, -5000, 5000);
+
+  auto input = writeTape(tempDir + "/input.bin", data);
+  BinaryFileTape output(tempDir + "/output.bin", data.size() * sizeof(int),
+                        cfg);
+
+  SampleSorter sorter(64 * sizeof(int), cfg, 4, tempDir + "/work");
+  sorter.sort(*input, output);
+
+  std::sort(data.begin(), data.end());
+  ASSERT_EQ(readAll(output), data);
+  ASSERT_FALSE(fs::exists(tempDir + "/work"));
+}
+
+TEST_F(SampleSorterTest, LeavesPartitionFiles) {
+  auto data = randomData(250, -100, 100);
+
+  auto input = writeTape(tempDir + "/input_parts.bin", data);
+
+  SampleSorter sorter(32 * sizeof(int), cfg, 3, tempDir + "/work_parts");
+  auto files = sorter.sortToPartitions(*input, tempDir + "/part");
+
+  ASSERT_EQ(files.size(), 3u);
+
+  std::vector<int> concatenated;
+  for (const auto &file : files) {
+    BinaryFileTape part(file, fs::file_size(file), cfg);
+    auto values = readAll(part);
+
+    ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+    if (!concatenated.empty() && !values.empty()) {
+      ASSERT_LE(concatenated.back(), values.front());
+    }
+
+    concatenated.insert(concatenated.end(), values.begin(), values.end());
+  }
+
+  std::sort(data.begin(), data.end());
+  ASSERT_EQ(concatenated, data);
+}
+
+TEST_F(SampleSorterTest, HandlesDuplicateHeavyInput) {
+  std::vector<int> data(120, 7);
+  data[10] = -1;
+  data[90] = 100;
+
+  auto input = writeTape(tempDir + "/input_dups.bin", data);
+  BinaryFileTape output(tempDir + "/output_dups.bin",
+                        data.size() * sizeof(int), cfg);
+
+  SampleSorter sorter(16 * sizeof(int), cfg, 4, tempDir + "/work_dups");
+  sorter.sort(*input, output);
+
+  std::sort(data.begin(), data.end());
+  ASSERT_EQ(readAll(output), data);
+}
+
+TEST_F(SampleSorterTest, PassesSettingsToBucketSorters) {
+  auto data = randomData(400, -5000, 5000);
+
+  auto input = writeTape(tempDir + "/input_traced.bin", data);
+  BinaryFileTape output(tempDir + "/output_traced.bin",
+                        data.size() * sizeof(int), cfg);
+
+  const std::string traceFile = tempDir + "/sample.trace";
+
+  {
+    TraceRecorder recorder(traceFile);
+
+    SampleSorter sorter(32 * sizeof(int), cfg, 2, tempDir + "/work_traced");
+    sorter.setMergeStrategy(MergeStrategy::Async);
+    sorter.setTraceRecorder(&recorder);
+    sorter.sort(*input, output);
+
+    // Две корзины по ~200 элементов при 16 элементах памяти на корзину.
+    EXPECT_GE(sorter.getStats().runs, 2 * 200 / 16);
+    EXPECT_GT(sorter.getStats().mergedElements, data.size());
+  }
+
+  std::sort(data.begin(), data.end());
+  ASSERT_EQ(readAll(output), data);
+
+  // Корзины, их выходы и временные ленты сортировщиков.
+  const TraceSummary &summary = TraceReplayer(traceFile).getSummary();
+  EXPECT_GT(summary.tapes, 4u);
+  EXPECT_GE(summary.count(TraceOp::Write), 2 * data.size());
+}
@@ -0,0 +1,209 @@
+#include "../include/entities/SetOperations.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+#include "CountingTape.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class SetOperationsTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  std::unique_ptr<BinaryFileTape> makeTape(const std::string &name,
+                                           const std::vector<int> &data,
+                                           size_t maxElements = 0) {
+    auto tape = std::make_unique<BinaryFileTape>(
+        tempDir + "/" + name,
+        std::max(maxElements, data.size()) * sizeof(int), TapeConfig{});
+
+    for (int value : data) {
+      tape->write(value);
+      tape->moveRight();
+    }
+
+    tape->rewind();
+    return tape;
+  }
+
+  static std::vector<int> readAll(TapeInterface &tape) {
+    std::vector<int> values;
+    tape.rewind();
+
+    while (!tape.isAtEnd()) {
+      values.push_back(tape.read());
+      tape.moveRight();
+    }
+
+    return values;
+  }
+
+  static std::vector<int> expected(SetOperation operation,
+                                   const std::vector<int> &a,
+                                   const std::vector<int> &b) {
+    std::vector<int> result;
+    auto out = std::back_inserter(result);
+
+    switch (operation) {
+    case SetOperation::Union:
+      std::set_union(a.begin(), a.end(), b.begin(), b.end(), out);
+      break;
+    case SetOperation::Intersection:
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out);
+      break;
+    case SetOperation::Difference:
+      std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out);
+      break;
+    case SetOperation::Merge:
+      std::merge(a.begin(), a.end(), b.begin(), b.end(), out);
+      break;
+    }
+
+    return result;
+  }
+
+  const std::string tempDir = "set_operations_test_tmp";
+};
+
+TEST_F(SetOperationsTest, MatchesStandardMultisetAlgorithms) {
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> dist(0, 30);
+  std::uniform_int_distribution<size_t> length(0, 200);
+
+  for (int round = 0; round < 20; ++round) {
+    std::vector<int> a(length(rng));
+    std::vector<int> b(length(rng));
+    std::generate(a.begin(), a.end(), [&] { return dist(rng); });
+    std::generate(b.begin(), b.end(), [&] { return dist(rng); });
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+
+    fs::remove(tempDir + "/left.bin");
+    fs::remove(tempDir + "/right.bin");
+
+    auto left = makeTape("left.bin", a);
+    auto right = makeTape("right.bin", b);
+
+    for (const bool gallop : {false, true}) {
+      for (const SetOperation operation :
+           {SetOperation::Union, SetOperation::Intersection,
+            SetOperation::Difference, SetOperation::Merge}) {
+        fs::remove(tempDir + "/out.bin");
+        auto output = makeTape("out.bin", {}, a.size() + b.size());
+
+        // Блоки по 4 элемента: ключи часто пересекают границы блоков.
+        SetOperations operations(8 * sizeof(int), gallop);
+        const auto want = expected(operation, a, b);
+
+        EXPECT_EQ(operations.apply(operation, *left, *right, *output),
+                  want.size());
+        EXPECT_EQ(readAll(*output), want)
+            << "round " << round << ", gallop " << gallop;
+      }
+    }
+  }
+}
+
+TEST_F(SetOperationsTest, JoinReportsMultiplicities) {
+  auto left = makeTape("left.bin", {1, 2, 2, 4, 4, 4, 7});
+  auto right = makeTape("right.bin", {2, 3, 4, 4, 7, 7, 9});
+
+  std::vector<std::tuple<int, size_t, size_t>> matches;
+  SetOperations operations(4 * sizeof(int), true);
+
+  EXPECT_EQ(operations.join(*left, *right,
+                            [&](int key, size_t a, size_t b) {
+                              matches.emplace_back(key, a, b);
+                            }),
+            3u);
+
+  EXPECT_EQ(matches, (std::vector<std::tuple<int, size_t, size_t>>{
+                         {2, 2, 1}, {4, 3, 2}, {7, 1, 2}}));
+}
+
+TEST_F(SetOperationsTest, ReadsEachInputInOnePass) {
+  std::vector<int> a;
+  std::vector<int> b;
+  for (int i = 0; i < 300; ++i) {
+    a.push_back(i * 2);
+    b.push_back(i * 3);
+  }
+
+  auto left = makeTape("left.bin", a);
+  auto right = makeTape("right.bin", b);
+  auto output = makeTape("out.bin", {}, a.size() + b.size());
+
+  CountingTape countedLeft(*left);
+  CountingTape countedRight(*right);
+
+  SetOperations operations(16 * sizeof(int), true);
+  operations.apply(SetOperation::Union, countedLeft, countedRight, *output);
+
+  for (const CountingTape *tape : {&countedLeft, &countedRight}) {
+    EXPECT_EQ(tape->rewinds, 1u);
+    EXPECT_EQ(tape->leftShifts, 0u);
+    EXPECT_EQ(tape->reads, 300u);
+  }
+}
+
+TEST_F(SetOperationsTest, GallopingSkipsLongSideInFewComparisons) {
+  std::vector<int> small;
+  std::vector<int> large;
+  for (int i = 0; i < 10; ++i) {
+    small.push_back(i * 1000 + 500);
+  }
+  for (int i = 0; i < 10000; ++i) {
+    large.push_back(i);
+  }
+
+  auto left = makeTape("left.bin", small);
+  auto right = makeTape("right.bin", large);
+
+  size_t comparisons[2] = {};
+
+  for (const bool gallop : {false, true}) {
+    fs::remove(tempDir + "/out.bin");
+    auto output = makeTape("out.bin", {}, small.size());
+
+    SetOperations operations(1024 * sizeof(int), gallop);
+    EXPECT_EQ(operations.apply(SetOperation::Intersection, *left, *right,
+                               *output),
+              10u);
+    EXPECT_EQ(readAll(*output), small);
+
+    comparisons[gallop] = operations.getStats().comparisons;
+  }
+
+  EXPECT_GE(comparisons[false], 9000u);
+  EXPECT_LT(comparisons[true] * 20, comparisons[false]);
+}
+
+TEST_F(SetOperationsTest, EmptyInputs) {
+  auto empty = makeTape("empty.bin", {});
+  auto values = makeTape("values.bin", {1, 1, 2});
+  auto output = makeTape("out.bin", {}, 3);
+
+  SetOperations operations(4 * sizeof(int));
+
+  EXPECT_EQ(operations.apply(SetOperation::Union, *empty, *values, *output),
+            3u);
+  EXPECT_EQ(readAll(*output), (std::vector<int>{1, 1, 2}));
+
+  EXPECT_EQ(
+      operations.apply(SetOperation::Difference, *empty, *values, *output),
+      0u);
+  EXPECT_EQ(operations.apply(SetOperation::Intersection, *values, *empty,
+                             *output),
+            0u);
+  EXPECT_EQ(operations.join(*empty, *empty, [](int, size_t, size_t) {}), 0u);
+}
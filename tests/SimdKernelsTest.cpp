@@ -0,0 +1,77 @@
+#include "../include/utils/simdKernels.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using utils::simd::Isa;
+
+namespace {
+
+std::vector<int> randomData(std::mt19937 &rng, size_t n, int range) {
+  std::uniform_int_distribution<int> dist(-range, range);
+
+  std::vector<int> data(n);
+  for (auto &value : data)
+    value = dist(rng);
+
+  return data;
+}
+
+} // namespace
+
+TEST(SimdKernelsTest, MergeMatchesStdMerge) {
+  std::mt19937 rng(5);
+
+  for (Isa isa : {Isa::Scalar, Isa::Sse41, Isa::Avx2}) {
+    for (size_t na : {0u, 1u, 3u, 4u, 8u, 15u, 16u, 33u, 200u}) {
+      for (size_t nb : {0u, 2u, 7u, 8u, 9u, 64u, 131u}) {
+        for (int range : {3, 1000, INT_MAX}) {
+          auto a = randomData(rng, na, range);
+          auto b = randomData(rng, nb, range);
+          std::sort(a.begin(), a.end());
+          std::sort(b.begin(), b.end());
+
+          std::vector<int> expected(na + nb);
+          std::merge(a.begin(), a.end(), b.begin(), b.end(),
+                     expected.begin());
+
+          std::vector<int> out(na + nb);
+          utils::simd::merge(a.data(), na, b.data(), nb, out.data(), isa);
+
+          ASSERT_EQ(out, expected) << utils::simd::isaName(isa) << " na="
+                                   << na << " nb=" << nb;
+        }
+      }
+    }
+  }
+}
+
+TEST(SimdKernelsTest, SortMatchesStdSort) {
+  std::mt19937 rng(11);
+
+  for (Isa isa : {Isa::Scalar, Isa::Sse41, Isa::Avx2}) {
+    for (size_t n : {0u, 1u, 5u, 16u, 17u, 63u, 64u, 65u, 500u, 1024u,
+                     1025u, 3000u}) {
+      for (int range : {2, 100000, INT_MAX}) {
+        auto data = randomData(rng, n, range);
+        auto expected = data;
+        std::sort(expected.begin(), expected.end());
+
+        utils::simd::sort(data.data(), n, isa);
+        ASSERT_EQ(data, expected)
+            << utils::simd::isaName(isa) << " n=" << n;
+      }
+    }
+  }
+}
+
+TEST(SimdKernelsTest, UnsupportedIsaFallsBack) {
+  EXPECT_LE(utils::simd::detectIsa(), Isa::Avx2);
+
+  std::vector<int> data = {3, INT_MIN, 2, INT_MAX, 2};
+  utils::simd::sort(data.data(), data.size());
+  EXPECT_EQ(data, (std::vector<int>{INT_MIN, 2, 2, 3, INT_MAX}));
+}
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../include/daemon/SortDaemon.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+
+namespace fs = std::filesystem;
+
+class SortDaemonTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(spoolDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  const std::string tempDir = "sort_daemon_test_tmp";
+  const std::string spoolDir = tempDir + "/spool";
+
+  TapeConfig cfg{0, 0, 0, 0};
+
+  DaemonOptions options() const {
+    DaemonOptions result;
+    result.spoolDir = spoolDir;
+    result.tmpDir = tempDir + "/work";
+    result.workers = 3;
+    result.memoryBudget = 64 * sizeof(int);
+    return result;
+  }
+
+  std::vector<int> writeInput(const std::string &file, size_t n,
+                              unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-500, 500);
+
+    std::vector<int> data(n);
+    BinaryFileTape tape(file, n * sizeof(int), cfg);
+
+    for (auto &value : data) {
+      value = dist(rng);
+      tape.write(value);
+      tape.moveRight();
+    }
+
+    return data;
+  }
+
+  void writeJob(const std::string &name, const std::string &body) {
+    std::ofstream file(spoolDir + "/" + name + ".job");
+    file << body;
+  }
+
+  std::vector<int> readOutput(const std::string &file) {
+    BinaryFileTape tape(file, fs::file_size(file), cfg);
+    std::vector<int> out;
+
+    while (!tape.isAtEnd()) {
+      out.push_back(tape.read());
+      tape.moveRight();
+    }
+
+    return out;
+  }
+};
+
+TEST_F(SortDaemonTest, RunsSpooledJobs) {
+  std::vector<std::vector<int>> inputs;
+
+  for (unsigned i = 0; i < 6; ++i) {
+    const std::string input = tempDir + "/in_" + std::to_string(i) + ".bin";
+    inputs.push_back(writeInput(input, 10 + 37 * i, i));
+
+    writeJob("job_" + std::to_string(i),
+             "# small job\n"
+             "input = " + input + "\n"
+             "output = " + tempDir + "/out_" + std::to_string(i) + ".bin\n"
+             "memory_limit = " + std::to_string(8 * sizeof(int)) + "\n" +
+                 (i % 2 == 0 ? "merge_strategy = backward\n" : ""));
+  }
+
+  SortDaemon daemon(cfg, options());
+  EXPECT_EQ(daemon.poll(), 6u);
+  daemon.waitIdle();
+
+  // Захваченные задания повторно не берутся.
+  EXPECT_EQ(daemon.poll(), 0u);
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    std::sort(inputs[i].begin(), inputs[i].end());
+    EXPECT_EQ(readOutput(tempDir + "/out_" + std::to_string(i) + ".bin"),
+              inputs[i]);
+    EXPECT_TRUE(fs::exists(spoolDir + "/job_" + std::to_string(i) + ".done"));
+    EXPECT_FALSE(
+        fs::exists(spoolDir + "/job_" + std::to_string(i) + ".running"));
+  }
+
+  const auto metrics = daemon.getMetrics();
+  ASSERT_EQ(metrics.size(), 6u);
+
+  for (const auto &job : metrics) {
+    EXPECT_TRUE(job.succeeded) << job.error;
+    EXPECT_EQ(job.memoryBytes, 8 * sizeof(int));
+    EXPECT_GT(job.stats.runs, 0u);
+  }
+}
+
+TEST_F(SortDaemonTest, ReportsFailedJobs) {
+  const std::string input = tempDir + "/in_big.bin";
+  writeInput(input, 200, 7);
+
+  writeJob("bad_key", "input = a.bin\noutput = b.bin\ncolour = red\n");
+  writeJob("missing_input", "input = " + tempDir +
+                                "/absent.bin\noutput = " + tempDir +
+                                "/absent_out.bin\n");
+  writeJob("too_big", "input = " + input + "\noutput = " + tempDir +
+                          "/out_big.bin\nmemory_limit = 16\n");
+
+  DaemonOptions limited = options();
+  limited.tempDiskBudget = 100 * sizeof(int);
+
+  SortDaemon daemon(cfg, limited);
+  daemon.poll();
+  daemon.waitIdle();
+
+  for (const std::string name : {"bad_key", "missing_input", "too_big"}) {
+    EXPECT_TRUE(fs::exists(spoolDir + "/" + name + ".failed")) << name;
+  }
+
+  for (const auto &job : daemon.getMetrics()) {
+    EXPECT_FALSE(job.succeeded);
+    EXPECT_FALSE(job.error.empty());
+  }
+}
+
+TEST_F(SortDaemonTest, DaemonsSharingSpoolKeepSeparateTempFiles) {
+  std::vector<std::vector<int>> inputs;
+
+  for (unsigned i = 0; i < 8; ++i) {
+    const std::string input = tempDir + "/in_" + std::to_string(i) + ".bin";
+    inputs.push_back(writeInput(input, 300, i));
+
+    writeJob("job_" + std::to_string(i),
+             "input = " + input + "\noutput = " + tempDir + "/out_" +
+                 std::to_string(i) + ".bin\nmemory_limit = " +
+                 std::to_string(8 * sizeof(int)) + "\n");
+  }
+
+  {
+    // Одинаковые опции: временные каталоги совпали бы, если бы не
+    // собственный подкаталог каждого демона.
+    SortDaemon first(cfg, options());
+    SortDaemon second(cfg, options());
+
+    std::thread other([&] {
+      second.poll();
+      second.waitIdle();
+    });
+
+    first.poll();
+    first.waitIdle();
+    other.join();
+
+    EXPECT_EQ(first.getMetrics().size() + second.getMetrics().size(), 8u);
+
+    for (const auto &metrics : {first.getMetrics(), second.getMetrics()}) {
+      for (const auto &job : metrics) {
+        EXPECT_TRUE(job.succeeded) << job.error;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    std::sort(inputs[i].begin(), inputs[i].end());
+    EXPECT_EQ(readOutput(tempDir + "/out_" + std::to_string(i) + ".bin"),
+              inputs[i]);
+  }
+
+  // Демоны удаляют свои подкаталоги при остановке.
+  EXPECT_TRUE(fs::is_empty(tempDir + "/work"));
+}
+
+TEST_F(SortDaemonTest, RejectsMissingSpoolDirectory) {
+  DaemonOptions missing = options();
+  missing.spoolDir = tempDir + "/nowhere";
+
+  EXPECT_THROW(SortDaemon(cfg, missing), std::runtime_error);
+}
+
+TEST(ResourceBudgetTest, LeaseReturnsCapacity) {
+  ResourceBudget budget(100);
+
+  {
+    ResourceBudget::Lease lease(budget, 60);
+    EXPECT_EQ(budget.getAvailable(), 40u);
+  }
+
+  EXPECT_EQ(budget.getAvailable(), 100u);
+  EXPECT_THROW(budget.acquire(101), std::invalid_argument);
+}
+
+TEST(ResourceBudgetTest, AcquireWaitsForRelease) {
+  ResourceBudget budget(10);
+  budget.acquire(10);
+
+  std::thread waiter([&] {
+    ResourceBudget::Lease lease(budget, 5);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  budget.release(10);
+  waiter.join();
+
+  EXPECT_EQ(budget.getAvailable(), 10u);
+}
@@ -0,0 +1,229 @@
+#include "../include/entities/TapeSorter.tpp"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class SortOrderTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  std::unique_ptr<BinaryFileTape> makeTape(const std::string &name,
+                                           const std::vector<int> &data) {
+    fs::remove(tempDir + "/" + name);
+
+    auto tape = std::make_unique<BinaryFileTape>(
+        tempDir + "/" + name, data.size() * sizeof(int), cfg);
+
+    for (int value : data) {
+      tape->write(value);
+      tape->moveRight();
+    }
+
+    tape->rewind();
+    return tape;
+  }
+
+  static std::vector<int> readTape(TapeInterface &tape) {
+    std::vector<int> values;
+
+    tape.rewind();
+    for (size_t i = 0; i < tape.getSize(); ++i) {
+      values.push_back(tape.read());
+      tape.moveRight();
+    }
+
+    return values;
+  }
+
+  static std::vector<int> randomValues(size_t count, int range,
+                                       unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(-range, range);
+
+    std::vector<int> values(count);
+    for (int &value : values) {
+      value = dist(gen);
+    }
+
+    return values;
+  }
+
+  /// @brief Сортирует values через BasicTapeSorter<Order> и возвращает
+  /// выход.
+  template <typename Order>
+  std::vector<int> sortWith(const std::vector<int> &values,
+                            MergeStrategy strategy, size_t memory) {
+    auto input = makeTape("in.bin", values);
+    auto output = makeTape("out.bin", std::vector<int>(values.size(), 0));
+
+    BasicTapeSorter<Order> sorter(memory, cfg, tempDir + "/tmp");
+    sorter.setMergeStrategy(strategy);
+    sorter.sort(*input, *output);
+
+    return readTape(*output);
+  }
+
+  const std::string tempDir = "sort_order_test_tmp";
+  const TapeConfig cfg{0, 0, 0, 0};
+};
+
+namespace {
+
+const MergeStrategy kStrategies[] = {
+    MergeStrategy::Pairwise, MergeStrategy::ReadBackward, MergeStrategy::Async,
+    MergeStrategy::Forecast};
+
+} // namespace
+
+/// @brief Порядок, которого нет среди готовых: сначала чётные, затем
+/// нечётные, внутри — по возрастанию.
+struct EvenFirst {
+  bool operator()(int a, int b) const {
+    return std::pair(a % 2 != 0, a) < std::pair(b % 2 != 0, b);
+  }
+};
+
+using EvenFirstOrder = SortOrder<EvenFirst>;
+
+// Инстанцирование вне библиотеки, как в проекте, подключившем пакет.
+template class BasicTapeSorter<EvenFirstOrder>;
+
+TEST_F(SortOrderTest, DescendingEveryStrategy) {
+  for (MergeStrategy strategy : kStrategies) {
+    for (size_t n : {0u, 5u, 301u}) {
+      const auto values = randomValues(n, 1000, static_cast<unsigned>(n));
+
+      auto expected = values;
+      std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+      EXPECT_EQ(sortWith<Descending>(values, strategy, 8 * sizeof(int)),
+                expected)
+          << "n = " << n;
+    }
+  }
+}
+
+TEST_F(SortOrderTest, DescendingCountingSortAndTopK) {
+  std::vector<int> values(500);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i % 5) - 2;
+  }
+
+  auto expected = values;
+  std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+  auto input = makeTape("in.bin", values);
+  auto output = makeTape("out.bin", std::vector<int>(values.size(), 0));
+
+  BasicTapeSorter<Descending> sorter(256, cfg, tempDir + "/tmp");
+  sorter.sort(*input, *output);
+
+  EXPECT_TRUE(sorter.getStats().countingSort);
+  EXPECT_EQ(readTape(*output), expected);
+
+  const auto random = randomValues(300, 1000, 4);
+  auto top = random;
+  std::sort(top.begin(), top.end(), std::greater<int>());
+  top.resize(10);
+
+  auto topInput = makeTape("top_in.bin", random);
+  auto topOutput = makeTape("top_out.bin", std::vector<int>(10, 0));
+
+  sorter.sortTopK(*topInput, *topOutput, 10);
+  EXPECT_EQ(readTape(*topOutput), top);
+}
+
+TEST_F(SortOrderTest, MagnitudeOrder) {
+  const auto values = randomValues(301, 50, 8);
+
+  for (MergeStrategy strategy : kStrategies) {
+    const auto result = sortWith<ByMagnitude>(values, strategy, 32);
+
+    EXPECT_TRUE(std::is_sorted(result.begin(), result.end(), MagnitudeLess()));
+    EXPECT_TRUE(std::is_permutation(result.begin(), result.end(),
+                                    values.begin(), values.end()));
+  }
+}
+
+TEST_F(SortOrderTest, StableMagnitudeKeepsInputOrder) {
+  // Ключи повторяются с обоими знаками, поэтому неустойчивое слияние
+  // переставило бы -k и k.
+  const auto values = randomValues(1000, 20, 15);
+
+  auto expected = values;
+  std::stable_sort(expected.begin(), expected.end(), MagnitudeLess());
+
+  for (MergeStrategy strategy : kStrategies) {
+    for (size_t memory : {8 * sizeof(int), 100 * sizeof(int)}) {
+      EXPECT_EQ(sortWith<StableByMagnitude>(values, strategy, memory),
+                expected);
+    }
+  }
+
+  auto input = makeTape("in.bin", values);
+  auto output = makeTape("out.bin", std::vector<int>(50, 0));
+
+  BasicTapeSorter<StableByMagnitude> sorter(100 * sizeof(int), cfg,
+                                            tempDir + "/tmp");
+  sorter.sortTopK(*input, *output, 50);
+
+  expected.resize(50);
+  EXPECT_EQ(readTape(*output), expected);
+}
+
+TEST_F(SortOrderTest, StableMergeSortedKeepsInputOrder) {
+  const auto first = randomValues(40, 10, 1);
+  const auto second = randomValues(70, 10, 2);
+
+  auto left = makeTape("left.bin", first);
+  auto right = makeTape("right.bin", second);
+  auto output = makeTape("out.bin", std::vector<int>(110, 0));
+
+  BasicTapeSorter<StableByMagnitude> sorter(16 * sizeof(int), cfg,
+                                            tempDir + "/tmp");
+  sorter.mergeSorted({left.get(), right.get()}, *output);
+
+  auto expected = first;
+  expected.insert(expected.end(), second.begin(), second.end());
+  std::stable_sort(expected.begin(), expected.end(), MagnitudeLess());
+
+  EXPECT_EQ(readTape(*output), expected);
+}
+
+TEST_F(SortOrderTest, VerifiesInOrder) {
+  const auto values = randomValues(301, 1000, 6);
+  auto input = makeTape("in.bin", values);
+  auto output = makeTape("out.bin", std::vector<int>(values.size(), 0));
+
+  BasicTapeSorter<Descending> sorter(8 * sizeof(int), cfg, tempDir + "/tmp");
+  sorter.setVerify(true);
+  sorter.sort(*input, *output);
+
+  EXPECT_TRUE(sorter.getStats().verification->ok());
+
+  EXPECT_TRUE(verifySorted(*output, input.get(), &Descending::less).ok());
+  EXPECT_FALSE(verifySorted(*output).sorted);
+}
+
+TEST_F(SortOrderTest, CustomOrderInstantiatedFromTemplate) {
+  const auto values = randomValues(301, 1000, 9);
+
+  auto expected = values;
+  std::sort(expected.begin(), expected.end(), EvenFirst());
+
+  for (MergeStrategy strategy : kStrategies) {
+    EXPECT_EQ(sortWith<EvenFirstOrder>(values, strategy, 8 * sizeof(int)),
+              expected);
+  }
+}
@@ -0,0 +1,184 @@
+#include "../include/entities/SortVerification.h"
+#include "../include/entities/TapeSorter.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class SortVerificationTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  std::unique_ptr<BinaryFileTape> makeTape(const std::string &name,
+                                           const std::vector<int> &data) {
+    auto tape = std::make_unique<BinaryFileTape>(
+        tempDir + "/" + name, data.size() * sizeof(int), cfg);
+
+    for (int value : data) {
+      tape->write(value);
+      tape->moveRight();
+    }
+
+    tape->rewind();
+    return tape;
+  }
+
+  std::vector<int> randomValues(size_t count, unsigned seed) const {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(-1000, 1000);
+
+    std::vector<int> values(count);
+    for (int &value : values) {
+      value = dist(gen);
+    }
+
+    return values;
+  }
+
+  const std::string tempDir = "sort_verification_test_tmp";
+  const TapeConfig cfg{0, 0, 0, 0};
+};
+
+TEST_F(SortVerificationTest, ChecksumIgnoresOrderButNotMultiplicity) {
+  Checksum a;
+  Checksum b;
+
+  for (int value : {3, -1, 7, 3}) {
+    a.add(value);
+  }
+
+  b.add(7);
+  b.add(3, 2);
+  b.add(-1);
+
+  EXPECT_EQ(a, b);
+
+  // Пара одинаковых значений не обнуляет сумму, как было бы с XOR.
+  Checksum pair;
+  pair.add(5, 2);
+  EXPECT_NE(pair.sum, 0u);
+
+  Checksum changed = b;
+  changed.add(4);
+  b.add(3);
+  EXPECT_EQ(changed.count, b.count);
+  EXPECT_NE(changed, b);
+}
+
+TEST_F(SortVerificationTest, VerifyingTapeChecksWrites) {
+  auto file = makeTape("out.bin", std::vector<int>(4, 0));
+  VerifyingTape tape(*file);
+
+  // Первый проход перезаписывается после перемотки.
+  tape.write(9);
+  tape.moveRight();
+  tape.rewind();
+
+  for (int value : {1, 2, 2, 0}) {
+    tape.write(value);
+    tape.moveRight();
+  }
+
+  SortVerification result;
+  result.input.add(2, 2);
+  result.input.add(1);
+  result.input.add(0);
+
+  tape.report(result);
+  EXPECT_FALSE(result.sorted);
+  EXPECT_EQ(result.firstUnsorted, 3u);
+  EXPECT_EQ(result.input, result.output);
+  EXPECT_FALSE(result.ok());
+
+  tape.moveLeft();
+  EXPECT_THROW(tape.write(5), std::logic_error);
+}
+
+TEST_F(SortVerificationTest, VerifySortedFiles) {
+  auto input = makeTape("in.bin", {4, -2, 9, 4});
+  auto sorted = makeTape("sorted.bin", {-2, 4, 4, 9});
+  auto wrong = makeTape("wrong.bin", {-2, 4, 9, 9});
+  auto unsorted = makeTape("unsorted.bin", {-2, 9, 4, 4});
+
+  EXPECT_TRUE(verifySorted(*sorted, input.get()).ok());
+  EXPECT_TRUE(verifySorted(*sorted).ok());
+
+  const SortVerification lost = verifySorted(*wrong, input.get());
+  EXPECT_TRUE(lost.sorted);
+  EXPECT_FALSE(lost.ok());
+
+  const SortVerification order = verifySorted(*unsorted, input.get());
+  EXPECT_FALSE(order.sorted);
+  EXPECT_EQ(order.firstUnsorted, 2u);
+  EXPECT_EQ(order.input, order.output);
+}
+
+TEST_F(SortVerificationTest, SortVerifiesEveryStrategy) {
+  for (MergeStrategy strategy :
+       {MergeStrategy::Pairwise, MergeStrategy::ReadBackward,
+        MergeStrategy::Async, MergeStrategy::Forecast}) {
+    for (size_t n : {0u, 7u, 301u}) {
+      const auto values = randomValues(n, static_cast<unsigned>(n));
+      auto input = makeTape("in.bin", values);
+      BinaryFileTape output(tempDir + "/out_" + std::to_string(n) + ".bin",
+                            n * sizeof(int), cfg);
+
+      TapeSorter sorter(8 * sizeof(int), cfg, tempDir + "/tmp");
+      sorter.setMergeStrategy(strategy);
+      sorter.setVerify(true);
+      sorter.sort(*input, output);
+
+      const auto &verification = sorter.getStats().verification;
+      ASSERT_TRUE(verification);
+      EXPECT_TRUE(verification->ok()) << "n = " << n;
+      EXPECT_EQ(verification->output.count, n);
+
+      fs::remove(tempDir + "/in.bin");
+    }
+  }
+}
+
+TEST_F(SortVerificationTest, CountingSortIsVerified) {
+  std::vector<int> values(500);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i % 5) - 2;
+  }
+
+  auto input = makeTape("in.bin", values);
+  BinaryFileTape output(tempDir + "/out.bin", values.size() * sizeof(int),
+                        cfg);
+
+  TapeSorter sorter(256, cfg, tempDir + "/tmp");
+  sorter.setVerify(true);
+  sorter.sort(*input, output);
+
+  ASSERT_TRUE(sorter.getStats().countingSort);
+  EXPECT_TRUE(sorter.getStats().verification->ok());
+  EXPECT_EQ(sorter.getStats().verification->input.count, values.size());
+}
+
+TEST_F(SortVerificationTest, VerificationAddsNoPasses) {
+  const auto values = randomValues(301, 3);
+  auto input = makeTape("in.bin", values);
+  BinaryFileTape output(tempDir + "/out.bin", values.size() * sizeof(int),
+                        cfg);
+
+  TapeSorter sorter(8 * sizeof(int), cfg, tempDir + "/tmp");
+  sorter.sort(*input, output);
+  const SortStats plain = sorter.getStats();
+
+  sorter.setVerify(true);
+  sorter.sort(*input, output);
+
+  EXPECT_EQ(sorter.getStats().rewinds, plain.rewinds);
+  EXPECT_EQ(sorter.getStats().mergedElements, plain.mergedElements);
+}
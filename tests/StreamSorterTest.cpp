@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/entities/StreamSorter.h"
+#include "../include/entities/streamTapes/CallbackTape.h"
+#include "../include/entities/streamTapes/GeneratorTape.h"
+
+namespace fs = std::filesystem;
+
+class StreamSorterTest : public ::testing::Test {
+protected:
+  void TearDown() override { fs::remove_all(tmpDir); }
+
+  const std::string tmpDir = "stream_sorter_test_tmp";
+
+  static std::vector<int> randomData(size_t n) {
+    std::mt19937 rng(static_cast<unsigned>(n));
+    std::uniform_int_distribution<int> dist(-10000, 10000);
+
+    std::vector<int> data(n);
+    for (auto &value : data)
+      value = dist(rng);
+
+    return data;
+  }
+};
+
+TEST_F(StreamSorterTest, SortsRangeIntoOutputIterator) {
+  for (size_t n : {0u, 1u, 7u, 100u, 1000u}) {
+    const std::vector<int> data = randomData(n);
+
+    StreamSorter sorter(16 * sizeof(int), {}, tmpDir);
+    std::vector<int> out;
+    sorter.sort(data, std::back_inserter(out));
+
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(out, expected) << "n = " << n;
+  }
+}
+
+TEST_F(StreamSorterTest, FittingDataAvoidsTempFiles) {
+  const std::list<int> data = {5, -1, 3, 3, 0};
+
+  StreamSorter sorter(1024, {}, tmpDir);
+  std::vector<int> out;
+  sorter.sort(data, [&](int value) {
+    EXPECT_FALSE(fs::exists(tmpDir));
+    out.push_back(value);
+  });
+
+  EXPECT_EQ(out, (std::vector<int>{-1, 0, 3, 3, 5}));
+  EXPECT_EQ(sorter.getStats().runs, 1u);
+}
+
+TEST_F(StreamSorterTest, SpillsLargeGenerator) {
+  int next = 500;
+
+  StreamSorter sorter(32 * sizeof(int), {}, tmpDir);
+  std::vector<int> out;
+  sorter.sort(
+      [&]() -> std::optional<int> {
+        if (next == 0)
+          return std::nullopt;
+        return next--;
+      },
+      [&](int value) { out.push_back(value); });
+
+  ASSERT_EQ(out.size(), 500u);
+  EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+  EXPECT_EQ(out.front(), 1);
+  EXPECT_GT(sorter.getStats().runs, 1u);
+  EXPECT_FALSE(fs::exists(tmpDir));
+}
+
+TEST_F(StreamSorterTest, SortsIstream) {
+  std::istringstream input("3 -7\n12\t0 3\n");
+
+  StreamSorter sorter(2 * sizeof(int), {}, tmpDir);
+  std::vector<int> out;
+  sorter.sort(input, [&](int value) { out.push_back(value); });
+
+  EXPECT_EQ(out, (std::vector<int>{-7, 0, 3, 3, 12}));
+}
+
+TEST_F(StreamSorterTest, InvalidIstreamThrows) {
+  std::istringstream input("1 2 x 3");
+
+  StreamSorter sorter(1024, {}, tmpDir);
+  EXPECT_THROW(sorter.sort(input, [](int) {}), std::runtime_error);
+}
+
+TEST(StreamTapesTest, GeneratorTapeIsForwardOnly) {
+  std::vector<int> values = {4, 2};
+  size_t index = 0;
+
+  GeneratorTape tape([&]() -> std::optional<int> {
+    if (index == values.size())
+      return std::nullopt;
+    return values[index++];
+  });
+
+  tape.rewind();
+  EXPECT_EQ(tape.read(), 4);
+  EXPECT_EQ(tape.read(), 4);
+  tape.moveRight();
+  EXPECT_EQ(tape.read(), 2);
+  tape.moveRight();
+  EXPECT_TRUE(tape.isAtEnd());
+  EXPECT_EQ(tape.getSize(), 2u);
+
+  EXPECT_THROW(tape.read(), std::out_of_range);
+  EXPECT_THROW(tape.rewind(), std::logic_error);
+  EXPECT_THROW(tape.moveLeft(), std::logic_error);
+  EXPECT_THROW(tape.write(1), std::logic_error);
+}
+
+TEST(StreamTapesTest, CallbackTapeOnlyAppends) {
+  std::vector<int> out;
+  CallbackTape tape([&](int value) { out.push_back(value); });
+
+  tape.write(1);
+  tape.moveRight();
+  tape.write(2);
+  EXPECT_THROW(tape.write(3), std::logic_error);
+  tape.moveRight();
+
+  EXPECT_EQ(out, (std::vector<int>{1, 2}));
+  EXPECT_EQ(tape.getSize(), 2u);
+  EXPECT_THROW(tape.read(), std::logic_error);
+}
@@ -185,3 +185,174 @@ TEST_F(TapeConfigFactoryTest, KeyWithSpaces) {
   TapeConfigFactory factory(filename);
   EXPECT_THROW(factory.create(), std::runtime_error);
 }
+
+TEST_F(TapeConfigFactoryTest, DirectIoFlags) {
+  const std::string filename = "testTempConfigFactory/directIo.cfg";
+
+  {
+    std::ofstream file(filename);
+    file << "input_direct_io = 1\n";
+    file << "temp_direct_io = 0\n";
+    file << "output_direct_io = 1\n";
+  }
+
+  TapeConfigFactory factory(filename);
+  TapeConfig config = factory.create();
+
+  EXPECT_TRUE(config.inputDirectIo);
+  EXPECT_FALSE(config.tempDirectIo);
+  EXPECT_TRUE(config.outputDirectIo);
+}
+
+TEST_F(TapeConfigFactoryTest, DirectIoFlagMustBeBoolean) {
+  const std::string filename = "testTempConfigFactory/directIoInvalid.cfg";
+
+  {
+    std::ofstream file(filename);
+    file << "temp_direct_io = 2\n";
+  }
+
+  TapeConfigFactory factory(filename);
+  EXPECT_THROW(factory.create(), std::runtime_error);
+}
+
+TEST_F(TapeConfigFactoryTest, WideMemoryLimit) {
+  const std::string filename = "testTempConfigFactory/memory.cfg";
+
+  {
+    // 16 ГиБ: не помещается ни в int, ни в 32-битный size.
+    std::ofstream file(filename);
+    file << "memory_limit = 17179869184\n";
+  }
+
+  EXPECT_EQ(TapeConfigFactory(filename).create().memoryLimit,
+            static_cast<size_t>(17179869184LL));
+
+  {
+    std::ofstream file(filename);
+    file << "memory_limit = 3\n";
+  }
+
+  EXPECT_THROW(TapeConfigFactory(filename).create(), std::runtime_error);
+}
+
+TEST_F(TapeConfigFactoryTest, DriveKeys) {
+  const std::string filename = "testTempConfigFactory/drives.cfg";
+
+  {
+    std::ofstream file(filename);
+    file << "drive.0.read_delay = 1\n";
+    file << "drive.0.write_delay = 2\n";
+    file << "drive.2.shift_delay = 7\n";
+    file << "drive.1.rewind_delay = 5\n";
+  }
+
+  TapeConfigFactory factory(filename);
+  TapeConfig config = factory.create();
+
+  ASSERT_EQ(config.drives.size(), 3u);
+  EXPECT_EQ(config.drives[0].readDelay, 1);
+  EXPECT_EQ(config.drives[0].writeDelay, 2);
+  EXPECT_EQ(config.drives[1].rewindDelay, 5);
+  EXPECT_EQ(config.drives[2].shiftDelay, 7);
+  EXPECT_EQ(config.drives[2].readDelay, 0);
+}
+
+TEST_F(TapeConfigFactoryTest, DriveKeysKeepWideMemoryLimit) {
+  const std::string filename = "testTempConfigFactory/drivesMemory.cfg";
+
+  {
+    std::ofstream file(filename);
+    file << "drive.0.read_delay = 1\n";
+    file << "memory_limit = 5000000000\n";
+  }
+
+  TapeConfigFactory factory(filename);
+  TapeConfig config = factory.create();
+
+  ASSERT_EQ(config.drives.size(), 1u);
+  EXPECT_EQ(config.drives[0].readDelay, 1);
+  EXPECT_EQ(config.memoryLimit, static_cast<size_t>(5000000000LL));
+}
+
+TEST_F(TapeConfigFactoryTest, InvalidDriveKeys) {
+  for (const std::string line :
+       {"drive.x.read_delay = 1", "drive.0.speed = 1", "drive..read_delay = 1",
+        "drive.0.read_delay = -1", "drive.100000.read_delay = 1"}) {
+    const std::string filename = "testTempConfigFactory/invalidDrive.cfg";
+
+    {
+      std::ofstream file(filename);
+      file << line << "\n";
+    }
+
+    TapeConfigFactory factory(filename);
+    EXPECT_THROW(factory.create(), std::runtime_error) << line;
+  }
+}
+
+TEST_F(TapeConfigFactoryTest, TempDirKeys) {
+  const std::string filename = "testTempConfigFactory/tempDirs.cfg";
+
+  {
+    std::ofstream file(filename);
+    file << "temp_dir = /mnt/scratch0\n";
+    file << "temp_dir = /mnt/scratch1\n";
+    file << "temp_placement = free_space\n";
+  }
+
+  TapeConfigFactory factory(filename);
+  TapeConfig config = factory.create();
+
+  EXPECT_EQ(config.tempDirs,
+            (std::vector<std::string>{"/mnt/scratch0", "/mnt/scratch1"}));
+  EXPECT_EQ(config.tempPlacement, TempPlacement::FreeSpace);
+}
+
+TEST_F(TapeConfigFactoryTest, InvalidTempPlacement) {
+  for (const std::string line : {"temp_placement = random", "temp_dir ="}) {
+    const std::string filename = "testTempConfigFactory/invalidTemp.cfg";
+
+    {
+      std::ofstream file(filename);
+      file << line << "\n";
+    }
+
+    TapeConfigFactory factory(filename);
+    EXPECT_THROW(factory.create(), std::runtime_error) << line;
+  }
+}
+
+TEST_F(TapeConfigFactoryTest, DurabilityKeys) {
+  const std::string filename = "testTempConfigFactory/durability.cfg";
+
+  {
+    std::ofstream file(filename);
+    file << "temp_durability = flush\n";
+    file << "output_durability = fsync\n";
+  }
+
+  TapeConfigFactory factory(filename);
+  TapeConfig config = factory.create();
+
+  EXPECT_EQ(config.tempDurability, Durability::Flush);
+  EXPECT_EQ(config.outputDurability, Durability::Fsync);
+
+  EXPECT_EQ(TapeConfig{}.tempDurability, Durability::None);
+  EXPECT_EQ(TapeConfig{}.outputDurability, Durability::Flush);
+}
+
+TEST_F(TapeConfigFactoryTest, InvalidDurability) {
+  for (const std::string line :
+       {"temp_durability = always", "output_durability = 1"}) {
+    const std::string filename = "testTempConfigFactory/invalidDurability.cfg";
+
+    {
+      std::ofstream file(filename);
+      file << line << "\n";
+    }
+
+    TapeConfigFactory factory(filename);
+    EXPECT_THROW(factory.create(), std::runtime_error) << line;
+  }
+}
@@ -1,11 +1,14 @@
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <random>
 #include <vector>
 
 #include "../include/entities/TapeSorter.h"
 #include "../include/entities/fileTapes/BinaryFileTape.h"
+#include "CountingTape.h"
 
 namespace fs = std::filesystem;
 
@@ -131,3 +134,704 @@ TEST_F(TapeSorterTest, LargeRandom) {
 
   ASSERT_EQ(result, expected);
 }
+
+TEST_F(TapeSorterTest, TopKInMemory) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> vec{7, -1, 3, 9, 0, 3, 12, -5, 4};
+  std::string inputFile = tempDir + "/input_topk.bin";
+  std::string outputFile = tempDir + "/output_topk.bin";
+
+  auto inputTape = makeTape(inputFile, vec, cfg);
+  BinaryFileTape outputTape(outputFile, vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(4 * sizeof(int), cfg);
+  sorter.sortTopK(*inputTape, outputTape, 4);
+
+  auto result = readTape(outputTape);
+  ASSERT_EQ(result, (std::vector<int>{-5, -1, 0, 3}));
+}
+
+TEST_F(TapeSorterTest, TopKExternal) {
+  TapeConfig cfg{0, 0, 0, 0};
+  size_t N = 300;
+  size_t K = 77;
+  std::vector<int> vec(N);
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  for (auto &v : vec)
+    v = dist(rng);
+
+  std::string inputFile = tempDir + "/input_topk_ext.bin";
+  std::string outputFile = tempDir + "/output_topk_ext.bin";
+
+  auto inputTape = makeTape(inputFile, vec, cfg);
+  BinaryFileTape outputTape(outputFile, N * sizeof(int), cfg);
+
+  TapeSorter sorter(10 * sizeof(int), cfg);
+  sorter.sortTopK(*inputTape, outputTape, K);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+  expected.resize(K);
+
+  ASSERT_EQ(readTape(outputTape), expected);
+}
+
+TEST_F(TapeSorterTest, TopKLargerThanInput) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> vec{3, 1, 2};
+  std::string inputFile = tempDir + "/input_topk_all.bin";
+  std::string outputFile = tempDir + "/output_topk_all.bin";
+
+  auto inputTape = makeTape(inputFile, vec, cfg);
+  BinaryFileTape outputTape(outputFile, vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(sizeof(int), cfg);
+  sorter.sortTopK(*inputTape, outputTape, 10);
+
+  ASSERT_EQ(readTape(outputTape), (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(TapeSorterTest, MergeSortedShards) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<std::vector<int>> shards{
+      {-4, 0, 3, 9}, {1, 2, 2, 15, 20}, {-10, 7}};
+
+  std::vector<std::unique_ptr<BinaryFileTape>> tapes;
+  std::vector<TapeInterface *> inputs;
+  std::vector<int> expected;
+
+  for (size_t i = 0; i < shards.size(); ++i) {
+    tapes.push_back(makeTape(tempDir + "/shard_" + std::to_string(i) + ".bin",
+                             shards[i], cfg));
+    inputs.push_back(tapes.back().get());
+    expected.insert(expected.end(), shards[i].begin(), shards[i].end());
+  }
+
+  std::sort(expected.begin(), expected.end());
+
+  BinaryFileTape outputTape(tempDir + "/merged.bin",
+                            expected.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(2 * sizeof(int), cfg);
+  sorter.mergeSorted(inputs, outputTape);
+
+  ASSERT_EQ(readTape(outputTape), expected);
+  ASSERT_EQ(readTape(*tapes[1]), shards[1]);
+}
+
+TEST_F(TapeSorterTest, MergeSortedFallsBackForUnsortedShard) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> sortedShard{1, 4, 8};
+  std::vector<int> unsortedShard{9, -3, 5, 0, 2};
+
+  auto first = makeTape(tempDir + "/sorted_shard.bin", sortedShard, cfg);
+  auto second = makeTape(tempDir + "/unsorted_shard.bin", unsortedShard, cfg);
+
+  BinaryFileTape outputTape(tempDir + "/merged_fallback.bin",
+                            8 * sizeof(int), cfg);
+
+  TapeSorter sorter(2 * sizeof(int), cfg);
+  sorter.mergeSorted({first.get(), second.get()}, outputTape);
+
+  ASSERT_EQ(readTape(outputTape),
+            (std::vector<int>{-3, 0, 1, 2, 4, 5, 8, 9}));
+}
+
+TEST_F(TapeSorterTest, ReadBackwardStrategySorts) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::mt19937 rng(99);
+  std::uniform_int_distribution<int> dist(-500, 500);
+
+  // Одна, две, три, пять и семь серий: проверяются чётное и нечётное число
+  // уровней и группы из трёх серий.
+  for (size_t n : {0u, 4u, 8u, 12u, 20u, 27u, 100u}) {
+    std::vector<int> vec(n);
+    for (auto &v : vec)
+      v = dist(rng);
+
+    std::string inputFile = tempDir + "/input_back_" + std::to_string(n);
+    std::string outputFile = tempDir + "/output_back_" + std::to_string(n);
+
+    auto inputTape = makeTape(inputFile + ".bin", vec, cfg);
+    BinaryFileTape outputTape(outputFile + ".bin", n * sizeof(int), cfg);
+
+    TapeSorter sorter(4 * sizeof(int), cfg);
+    sorter.setMergeStrategy(MergeStrategy::ReadBackward);
+    sorter.sort(*inputTape, outputTape);
+
+    std::vector<int> expected = vec;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(readTape(outputTape), expected) << "n = " << n;
+  }
+}
+
+TEST_F(TapeSorterTest, ReadBackwardStrategySavesRewinds) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> vec(64);
+
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<int> dist(-100, 100);
+  for (auto &v : vec)
+    v = dist(rng);
+
+  auto inputTape = makeTape(tempDir + "/input_rewinds.bin", vec, cfg);
+  BinaryFileTape pairwiseOutput(tempDir + "/output_pairwise.bin",
+                                vec.size() * sizeof(int), cfg);
+  BinaryFileTape backwardOutput(tempDir + "/output_backward.bin",
+                                vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(8 * sizeof(int), cfg);
+  sorter.sort(*inputTape, pairwiseOutput);
+  const SortStats pairwise = sorter.getStats();
+
+  sorter.setMergeStrategy(MergeStrategy::ReadBackward);
+  sorter.sort(*inputTape, backwardOutput);
+  const SortStats backward = sorter.getStats();
+
+  ASSERT_EQ(readTape(pairwiseOutput), readTape(backwardOutput));
+  EXPECT_EQ(pairwise.runs, 8u);
+  EXPECT_EQ(backward.runs, 8u);
+  EXPECT_EQ(backward.rewinds, 2u);
+  EXPECT_GT(pairwise.rewinds, backward.rewinds);
+}
+
+TEST_F(TapeSorterTest, SingleRunBypassesTempFiles) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> vec{4, -2, 9, 1};
+
+  auto inputTape = makeTape(tempDir + "/input_single.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_single.bin",
+                            vec.size() * sizeof(int), cfg);
+
+  // Каталог для временных файлов не может быть создан внутри обычного
+  // файла: сортировка пройдёт, только если временные ленты не нужны.
+  const std::string blocker = tempDir + "/blocker";
+  std::ofstream(blocker).put('x');
+
+  TapeSorter sorter(vec.size() * sizeof(int), cfg, blocker + "/tmp");
+  ASSERT_NO_THROW(sorter.sort(*inputTape, outputTape));
+
+  ASSERT_EQ(readTape(outputTape), (std::vector<int>{-2, 1, 4, 9}));
+  EXPECT_EQ(sorter.getStats().runs, 1u);
+  EXPECT_EQ(sorter.getStats().mergePasses, 0u);
+}
+
+TEST_F(TapeSorterTest, FinalMergeWritesOutputDirectly) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> vec{8, 3, 5, 1, 7, 2};
+
+  auto inputTape = makeTape(tempDir + "/input_two_runs.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_two_runs.bin",
+                            vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(3 * sizeof(int), cfg, tempDir + "/tmp_two_runs");
+  sorter.sort(*inputTape, outputTape);
+
+  ASSERT_EQ(readTape(outputTape), (std::vector<int>{1, 2, 3, 5, 7, 8}));
+  EXPECT_EQ(sorter.getStats().runs, 2u);
+  EXPECT_EQ(sorter.getStats().mergePasses, 1u);
+  // Вход, две серии и три ленты единственного слияния; копирования
+  // результата с перемоткой больше нет.
+  EXPECT_EQ(sorter.getStats().rewinds, 6u);
+}
+
+TEST_F(TapeSorterTest, DirectIoTempTapes) {
+  TapeConfig cfg{0, 0, 0, 0};
+  cfg.tempDirectIo = true;
+
+  std::vector<int> vec(200);
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> dist(-300, 300);
+  for (auto &v : vec)
+    v = dist(rng);
+
+  auto inputTape = makeTape(tempDir + "/input_direct.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_direct.bin",
+                            vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(16 * sizeof(int), cfg, tempDir + "/tmp_direct");
+  sorter.sort(*inputTape, outputTape);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(readTape(outputTape), expected);
+}
+
+TEST_F(TapeSorterTest, AsyncStrategySorts) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+
+  for (size_t n : {0u, 3u, 9u, 50u, 301u}) {
+    std::vector<int> vec(n);
+    for (auto &v : vec)
+      v = dist(rng);
+
+    auto inputTape = makeTape(
+        tempDir + "/input_async_" + std::to_string(n) + ".bin", vec, cfg);
+    BinaryFileTape outputTape(tempDir + "/output_async_" + std::to_string(n) +
+                                  ".bin",
+                              n * sizeof(int), cfg);
+
+    TapeSorter sorter(4 * sizeof(int), cfg, tempDir + "/tmp_async");
+    sorter.setMergeStrategy(MergeStrategy::Async);
+    sorter.sort(*inputTape, outputTape);
+
+    std::vector<int> expected = vec;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(readTape(outputTape), expected) << "n = " << n;
+  }
+}
+
+TEST_F(TapeSorterTest, AsyncStrategyOverlapsMerges) {
+  TapeConfig cfg{0, 0, 0, 0};
+  TapeConfig slow{0, 1, 0, 0};
+
+  std::vector<int> vec(32);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = static_cast<int>((i * 7) % 32);
+
+  auto inputTape = makeTape(tempDir + "/input_overlap.bin", vec, cfg);
+  BinaryFileTape pairwiseOutput(tempDir + "/output_overlap_pairwise.bin",
+                                vec.size() * sizeof(int), cfg);
+  BinaryFileTape asyncOutput(tempDir + "/output_overlap_async.bin",
+                             vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(4 * sizeof(int), slow, tempDir + "/tmp_overlap");
+
+  auto start = std::chrono::steady_clock::now();
+  sorter.sort(*inputTape, pairwiseOutput);
+  const auto pairwise = std::chrono::steady_clock::now() - start;
+
+  sorter.setMergeStrategy(MergeStrategy::Async);
+  start = std::chrono::steady_clock::now();
+  sorter.sort(*inputTape, asyncOutput);
+  const auto async = std::chrono::steady_clock::now() - start;
+
+  ASSERT_EQ(readTape(asyncOutput), readTape(pairwiseOutput));
+  EXPECT_LT(async, pairwise);
+}
+
+TEST_F(TapeSorterTest, AsyncStrategyOverlapsOutputWrites) {
+  TapeConfig cfg{0, 0, 0, 0};
+  TapeConfig slowRead{2, 0, 0, 0};
+  TapeConfig slowWrite{0, 2, 0, 0};
+
+  std::vector<int> vec(64);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = static_cast<int>((i * 7) % 64);
+
+  auto inputTape = makeTape(tempDir + "/input_final.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_final.bin",
+                            vec.size() * sizeof(int), slowWrite);
+
+  // Две серии и одно слияние прямо в выход.
+  TapeSorter sorter(32 * sizeof(int), slowRead, tempDir + "/tmp_final");
+  sorter.setMergeStrategy(MergeStrategy::Async);
+
+  const auto start = std::chrono::steady_clock::now();
+  sorter.sort(*inputTape, outputTape);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(readTape(outputTape), expected);
+
+  // Чтение серий и запись выхода идут одновременно: время ближе к одной
+  // из них, чем к сумме.
+  EXPECT_GE(elapsed, std::chrono::milliseconds(64 * 2));
+  EXPECT_LT(elapsed, std::chrono::milliseconds(64 * (2 + 2) * 3 / 4));
+}
+
+TEST_F(TapeSorterTest, AsyncStrategySortsOnDrives) {
+  TapeConfig cfg{0, 0, 0, 0};
+  TapeConfig withDrives = cfg;
+  withDrives.drives = {DriveConfig{0, 0, 0, 0}, DriveConfig{0, 0, 0, 0},
+                       DriveConfig{0, 0, 0, 0}};
+
+  std::mt19937 rng(23);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+
+  for (size_t n : {5u, 17u, 64u, 301u}) {
+    std::vector<int> vec(n);
+    for (auto &v : vec)
+      v = dist(rng);
+
+    auto inputTape = makeTape(
+        tempDir + "/input_drives_" + std::to_string(n) + ".bin", vec, cfg);
+    BinaryFileTape outputTape(tempDir + "/output_drives_" +
+                                  std::to_string(n) + ".bin",
+                              n * sizeof(int), cfg);
+
+    TapeSorter sorter(4 * sizeof(int), withDrives, tempDir + "/tmp_drives");
+    sorter.setMergeStrategy(MergeStrategy::Async);
+    sorter.sort(*inputTape, outputTape);
+
+    std::vector<int> expected = vec;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(readTape(outputTape), expected) << "n = " << n;
+  }
+}
+
+TEST_F(TapeSorterTest, SyncStrategiesSortOnDrives) {
+  TapeConfig cfg{0, 0, 0, 0};
+  cfg.drives = {DriveConfig{0, 0, 0, 0}, DriveConfig{0, 0, 0, 0}};
+
+  std::vector<int> vec(40);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = static_cast<int>((i * 13) % 40);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+
+  for (auto strategy : {MergeStrategy::Pairwise, MergeStrategy::ReadBackward}) {
+    auto inputTape = makeTape(tempDir + "/input_sync_drives.bin", vec, cfg);
+    BinaryFileTape outputTape(tempDir + "/output_sync_drives.bin",
+                              vec.size() * sizeof(int), cfg);
+
+    TapeSorter sorter(4 * sizeof(int), cfg, tempDir + "/tmp_sync_drives");
+    sorter.setMergeStrategy(strategy);
+    sorter.sort(*inputTape, outputTape);
+
+    ASSERT_EQ(readTape(outputTape), expected);
+  }
+}
+
+TEST_F(TapeSorterTest, CountingSortForFewDistinctValues) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::vector<int> vec(500);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = static_cast<int>((i * 7919) % 5) - 2;
+
+  auto inputTape = makeTape(tempDir + "/input_counting.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_counting.bin",
+                            vec.size() * sizeof(int), cfg);
+
+  const std::string tmpDir = tempDir + "/tmp_counting";
+  TapeSorter sorter(256, cfg, tmpDir);
+  sorter.sort(*inputTape, outputTape);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(readTape(outputTape), expected);
+
+  EXPECT_TRUE(sorter.getStats().countingSort);
+  EXPECT_EQ(sorter.getStats().runs, 0u);
+  EXPECT_FALSE(fs::exists(tmpDir));
+
+  BinaryFileTape topOutput(tempDir + "/output_counting_top.bin",
+                           vec.size() * sizeof(int), cfg);
+  sorter.sortTopK(*inputTape, topOutput, 120);
+
+  expected.resize(120);
+  ASSERT_EQ(readTape(topOutput), expected);
+  EXPECT_TRUE(sorter.getStats().countingSort);
+}
+
+TEST_F(TapeSorterTest, CountingSortFallsBackOnManyDistinctValues) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::vector<int> vec(500);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = static_cast<int>((i * 7919) % 997);
+
+  auto inputTape = makeTape(tempDir + "/input_no_counting.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_no_counting.bin",
+                            vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(256, cfg, tempDir + "/tmp_no_counting");
+  sorter.sort(*inputTape, outputTape);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(readTape(outputTape), expected);
+
+  EXPECT_FALSE(sorter.getStats().countingSort);
+  EXPECT_GT(sorter.getStats().runs, 1u);
+}
+
+TEST_F(TapeSorterTest, CountingSortSampleStartsFirstRun) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::vector<int> vec(500);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = static_cast<int>((i * 7919) % 997);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+
+  auto inputTape = makeTape(tempDir + "/input_sample.bin", vec, cfg);
+
+  for (MergeStrategy strategy :
+       {MergeStrategy::Pairwise, MergeStrategy::ReadBackward,
+        MergeStrategy::Async, MergeStrategy::Forecast}) {
+    BinaryFileTape outputTape(tempDir + "/output_sample.bin",
+                              vec.size() * sizeof(int), cfg);
+    CountingTape input(*inputTape);
+
+    TapeSorter sorter(256, cfg, tempDir + "/tmp_sample");
+    sorter.setMergeStrategy(strategy);
+    sorter.setVerify(true);
+    sorter.setSketch(4);
+    sorter.sort(input, outputTape);
+
+    ASSERT_EQ(readTape(outputTape), expected);
+    EXPECT_FALSE(sorter.getStats().countingSort);
+    EXPECT_TRUE(sorter.getStats().verification->ok());
+    EXPECT_EQ(sorter.getStats().sketch->quantiles.getCount(), vec.size());
+
+    // Отказ сортировки подсчётом не стоит лишней перемотки входа.
+    EXPECT_EQ(input.rewinds, 1u);
+  }
+}
+
+TEST_F(TapeSorterTest, CountingSortDropsCountsWhenPrefixMisleads) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  // Выборка из начала видит три значения, дальше их почти тысяча.
+  std::vector<int> vec(500);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = i < 200 ? static_cast<int>(i % 3)
+                     : static_cast<int>((i * 7919) % 997);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+
+  auto inputTape = makeTape(tempDir + "/input_misleading.bin", vec, cfg);
+
+  for (MergeStrategy strategy :
+       {MergeStrategy::Pairwise, MergeStrategy::ReadBackward,
+        MergeStrategy::Async, MergeStrategy::Forecast}) {
+    BinaryFileTape outputTape(tempDir + "/output_misleading.bin",
+                              vec.size() * sizeof(int), cfg);
+    CountingTape input(*inputTape);
+
+    TapeSorter sorter(256, cfg, tempDir + "/tmp_misleading");
+    sorter.setMergeStrategy(strategy);
+    sorter.setVerify(true);
+    sorter.setSketch(4);
+    sorter.sort(input, outputTape);
+
+    ASSERT_EQ(readTape(outputTape), expected);
+    EXPECT_FALSE(sorter.getStats().countingSort);
+    EXPECT_TRUE(sorter.getStats().verification->ok());
+    EXPECT_EQ(sorter.getStats().sketch->quantiles.getCount(), vec.size());
+
+    // Счётчики не переживают отказ: вход читается заново с начала.
+    EXPECT_EQ(input.rewinds, 2u);
+  }
+}
+
+TEST_F(TapeSorterTest, StripedTempDirsSort) {
+  std::vector<int> vec(200);
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<int> dist(-100000, 100000);
+  for (auto &v : vec)
+    v = dist(rng);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+
+  for (TempPlacement placement :
+       {TempPlacement::RoundRobin, TempPlacement::FreeSpace}) {
+    for (MergeStrategy strategy :
+         {MergeStrategy::Pairwise, MergeStrategy::ReadBackward,
+          MergeStrategy::Async}) {
+      TapeConfig cfg{0, 0, 0, 0};
+      cfg.tempPlacement = placement;
+      for (int disk = 0; disk < 3; ++disk)
+        cfg.tempDirs.push_back(tempDir + "/disk" + std::to_string(disk));
+
+      auto inputTape = makeTape(tempDir + "/input_striped.bin", vec, cfg);
+      BinaryFileTape outputTape(tempDir + "/output_striped.bin",
+                                vec.size() * sizeof(int), cfg);
+
+      TapeSorter sorter(16 * sizeof(int), cfg, "tmp_striped");
+      sorter.setMergeStrategy(strategy);
+      sorter.sort(*inputTape, outputTape);
+
+      ASSERT_EQ(readTape(outputTape), expected);
+
+      for (const std::string &root : cfg.tempDirs)
+        EXPECT_FALSE(fs::exists(root + "/tmp_striped")) << root;
+    }
+  }
+}
+
+TEST_F(TapeSorterTest, StripedTempDirsUseEveryDir) {
+  TapeConfig cfg{0, 0, 0, 0};
+  cfg.tempDirs = {tempDir + "/disk0", tempDir + "/disk1"};
+
+  // Во втором «диске» нельзя создать каталог: сортировка упадёт, как
+  // только очередная серия попадёт туда.
+  std::ofstream(cfg.tempDirs[1]).put('x');
+
+  std::vector<int> vec{9, 4, 7, 1, 8, 2, 6, 3};
+  auto inputTape = makeTape(tempDir + "/input_stripe_fail.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_stripe_fail.bin",
+                            vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(2 * sizeof(int), cfg, "tmp");
+  EXPECT_THROW(sorter.sort(*inputTape, outputTape), std::runtime_error);
+  EXPECT_FALSE(fs::exists(cfg.tempDirs[0] + "/tmp"));
+}
+
+TEST_F(TapeSorterTest, ForecastStrategySorts) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::mt19937 rng(23);
+  std::uniform_int_distribution<int> dist(-100000, 100000);
+
+  // Малый лимит даёт двухпутевые слияния в несколько проходов, большой —
+  // одно слияние степени 15.
+  for (auto [memory, n] : {std::pair<size_t, size_t>{8, 0},
+                           {8, 5},
+                           {8, 301},
+                           {1024, 20000}}) {
+    std::vector<int> vec(n);
+    for (auto &v : vec)
+      v = dist(rng);
+
+    auto inputTape = makeTape(tempDir + "/input_forecast.bin", vec, cfg);
+    BinaryFileTape outputTape(tempDir + "/output_forecast_" +
+                                  std::to_string(n) + ".bin",
+                              n * sizeof(int), cfg);
+
+    TapeSorter sorter(memory * sizeof(int), cfg, tempDir + "/tmp_forecast");
+    sorter.setMergeStrategy(MergeStrategy::Forecast);
+    sorter.sort(*inputTape, outputTape);
+
+    std::vector<int> expected = vec;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(readTape(outputTape), expected) << "n = " << n;
+
+    if (n == 20000) {
+      EXPECT_EQ(sorter.getStats().runs, 20u);
+      EXPECT_EQ(sorter.getStats().mergePasses, 2u);
+    }
+  }
+}
+
+TEST_F(TapeSorterTest, MergeSortedMergesShortestRunsFirst) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::vector<int> large(100);
+  for (size_t i = 0; i < large.size(); ++i)
+    large[i] = static_cast<int>(i) * 2;
+
+  std::vector<std::vector<int>> shards{large, {5}, {-1}, {77}, {3}};
+
+  std::vector<std::unique_ptr<BinaryFileTape>> tapes;
+  std::vector<TapeInterface *> inputs;
+  std::vector<int> expected;
+
+  for (size_t i = 0; i < shards.size(); ++i) {
+    tapes.push_back(makeTape(tempDir + "/uneven_" + std::to_string(i) + ".bin",
+                             shards[i], cfg));
+    inputs.push_back(tapes.back().get());
+    expected.insert(expected.end(), shards[i].begin(), shards[i].end());
+  }
+
+  std::sort(expected.begin(), expected.end());
+
+  BinaryFileTape outputTape(tempDir + "/uneven_merged.bin",
+                            expected.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(2 * sizeof(int), cfg, tempDir + "/tmp_uneven");
+  sorter.mergeSorted(inputs, outputTape, true);
+
+  ASSERT_EQ(readTape(outputTape), expected);
+
+  // Четыре короткие серии сливаются между собой (2 + 2 + 4), и длинная
+  // серия проходит одно слияние вместо трёх при попарном слиянии по
+  // индексам (101 + 2 + 103 + 104).
+  EXPECT_EQ(sorter.getStats().mergedElements, 112u);
+  EXPECT_EQ(sorter.getStats().mergePasses, 3u);
+}
+
+TEST_F(TapeSorterTest, LevelStrategiesEqualizeRuns) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> vec{9, 4, 7, 1, 8, 2, 6, 3, 5};
+
+  auto inputTape = makeTape(tempDir + "/input_equal.bin", vec, cfg);
+  BinaryFileTape outputTape(tempDir + "/output_equal.bin",
+                            vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(4 * sizeof(int), cfg, tempDir + "/tmp_equal");
+  sorter.setMergeStrategy(MergeStrategy::Async);
+  sorter.sort(*inputTape, outputTape);
+
+  ASSERT_EQ(readTape(outputTape), (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8,
+                                                    9}));
+
+  // Серии 3, 3, 3 вместо 4, 4, 1: первый уровень сливает 6 элементов,
+  // а не 8.
+  EXPECT_EQ(sorter.getStats().runs, 3u);
+  EXPECT_EQ(sorter.getStats().mergedElements, 15u);
+}
+
+TEST_F(TapeSorterTest, ParallelFinalMerge) {
+  TapeConfig cfg{0, 0, 0, 0};
+
+  std::vector<int> vec(3000);
+  std::mt19937 rng(41);
+  std::uniform_int_distribution<int> dist(-100000, 100000);
+  for (auto &v : vec)
+    v = dist(rng);
+
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end());
+
+  for (MergeStrategy strategy :
+       {MergeStrategy::Pairwise, MergeStrategy::Forecast}) {
+    auto inputTape = makeTape(tempDir + "/input_parallel.bin", vec, cfg);
+    BinaryFileTape outputTape(tempDir + "/output_parallel.bin",
+                              vec.size() * sizeof(int), cfg);
+
+    TapeSorter sorter(256 * sizeof(int), cfg, tempDir + "/tmp_parallel");
+    sorter.setMergeStrategy(strategy);
+    sorter.setMergeThreads(4);
+    sorter.sort(*inputTape, outputTape);
+
+    ASSERT_EQ(outputTape.getSize(), vec.size());
+    ASSERT_EQ(readTape(outputTape), expected);
+
+    // Параллельное слияние читает файлы напрямую и не перематывает ленты
+    // последнего слияния.
+    TapeSorter sequential(256 * sizeof(int), cfg, tempDir + "/tmp_parallel");
+    sequential.setMergeStrategy(strategy);
+    sequential.sort(*inputTape, outputTape);
+    EXPECT_LT(sorter.getStats().rewinds, sequential.getStats().rewinds);
+  }
+
+  auto inputTape = makeTape(tempDir + "/input_parallel_top.bin", vec, cfg);
+  BinaryFileTape topOutput(tempDir + "/output_parallel_top.bin",
+                           vec.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(256 * sizeof(int), cfg, tempDir + "/tmp_parallel_top");
+  sorter.setMergeThreads(3);
+  sorter.sortTopK(*inputTape, topOutput, 700);
+
+  expected.resize(700);
+  ASSERT_EQ(readTape(topOutput), expected);
+}
+
+TEST_F(TapeSorterTest, MergeSortedSingleShardIsCopied) {
+  TapeConfig cfg{0, 0, 0, 0};
+  std::vector<int> shard{-3, 0, 0, 5, 12};
+
+  auto inputTape = makeTape(tempDir + "/single_shard.bin", shard, cfg);
+  BinaryFileTape outputTape(tempDir + "/single_merged.bin",
+                            shard.size() * sizeof(int), cfg);
+
+  TapeSorter sorter(2 * sizeof(int), cfg, tempDir + "/tmp_single");
+  sorter.mergeSorted({inputTape.get()}, outputTape, true);
+
+  ASSERT_EQ(readTape(outputTape), shard);
+  EXPECT_EQ(sorter.getStats().mergedElements, shard.size());
+}
@@ -0,0 +1,201 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/entities/TapeSorter.h"
+#include "../include/entities/TapeView.h"
+#include "../include/entities/fileTapes/BinaryFileTape.h"
+#include "../include/trace/TraceRecorder.h"
+#include "../include/trace/TraceReplayer.h"
+#include "../include/trace/TracingTape.h"
+
+namespace fs = std::filesystem;
+
+class TraceTest : public ::testing::Test {
+protected:
+  void SetUp() override { fs::create_directories(tempDir); }
+
+  void TearDown() override { fs::remove_all(tempDir); }
+
+  const std::string tempDir = "trace_test_tmp";
+  const std::string traceFile = tempDir + "/ops.trace";
+
+  TapeConfig cfg{0, 0, 0, 0};
+};
+
+TEST_F(TraceTest, RecordsOperationsAndReplaysSequentialTime) {
+  {
+    TraceRecorder recorder(traceFile);
+    TracingTape tape(std::make_unique<BinaryFileTape>(
+                         tempDir + "/tape.bin", 3 * sizeof(int), cfg),
+                     recorder);
+
+    for (int i = 0; i < 3; ++i) {
+      tape.write(i);
+      tape.moveRight();
+    }
+
+    tape.rewind();
+    EXPECT_EQ(tape.read(), 0);
+    tape.moveRight();
+    tape.moveLeft();
+  }
+
+  TraceReplayer replayer(traceFile);
+  const TraceSummary &summary = replayer.getSummary();
+
+  EXPECT_EQ(summary.tapes, 1u);
+  EXPECT_EQ(summary.count(TraceOp::Write), 3u);
+  EXPECT_EQ(summary.count(TraceOp::MoveRight), 4u);
+  EXPECT_EQ(summary.count(TraceOp::MoveLeft), 1u);
+  EXPECT_EQ(summary.count(TraceOp::Rewind), 1u);
+  EXPECT_EQ(summary.count(TraceOp::Read), 1u);
+
+  // 1 * 10 + 3 * 20 + 1 * 30 + 5 * 40
+  EXPECT_EQ(replayer.simulate(TapeConfig{10, 20, 30, 40}), 300);
+  EXPECT_EQ(replayer.simulate(TapeConfig{10, 20, 30, 40}, 1), 300);
+}
+
+TEST_F(TraceTest, SkipsMovesTheTapeDoesNotMake) {
+  {
+    TraceRecorder recorder(traceFile);
+    TracingTape tape(std::make_unique<BinaryFileTape>(
+                         tempDir + "/edges.bin", 2 * sizeof(int), cfg),
+                     recorder);
+
+    // Влево от начала и вправо за максимальный размер лента не сдвигается.
+    tape.moveLeft();
+
+    for (int i = 0; i < 2; ++i) {
+      tape.write(i);
+      tape.moveRight();
+    }
+
+    tape.moveRight();
+
+    for (int i = 0; i < 3; ++i) {
+      tape.moveLeft();
+    }
+
+    EXPECT_EQ(tape.read(), 0);
+  }
+
+  const TraceSummary &summary = TraceReplayer(traceFile).getSummary();
+
+  EXPECT_EQ(summary.count(TraceOp::MoveRight), 2u);
+  EXPECT_EQ(summary.count(TraceOp::MoveLeft), 2u);
+}
+
+TEST_F(TraceTest, EncodesLargeTapeIds) {
+  {
+    TraceRecorder recorder(traceFile);
+
+    for (uint32_t id = 0; id < 300; ++id) {
+      recorder.registerTape();
+    }
+
+    recorder.record(5, TraceOp::Write);
+    recorder.record(31, TraceOp::Read);
+    recorder.record(299, TraceOp::Rewind);
+  }
+
+  TraceReplayer replayer(traceFile);
+
+  EXPECT_EQ(replayer.getSummary().tapes, 300u);
+  EXPECT_EQ(replayer.getSummary().count(TraceOp::Rewind), 1u);
+}
+
+TEST_F(TraceTest, DrivesOverlapWritesButReadsBlock) {
+  {
+    TraceRecorder recorder(traceFile);
+    recorder.registerTape();
+    recorder.registerTape();
+
+    for (int i = 0; i < 4; ++i) {
+      recorder.record(0, TraceOp::Write);
+      recorder.record(1, TraceOp::Write);
+    }
+  }
+
+  TraceReplayer writes(traceFile);
+  const TapeConfig slowWrites{0, 10, 0, 0};
+
+  EXPECT_EQ(writes.simulate(slowWrites), 80);
+  EXPECT_EQ(writes.simulate(slowWrites, 1), 80);
+  EXPECT_EQ(writes.simulate(slowWrites, 2), 40);
+
+  const std::string readsFile = tempDir + "/reads.trace";
+
+  {
+    TraceRecorder recorder(readsFile);
+    recorder.registerTape();
+    recorder.registerTape();
+
+    for (int i = 0; i < 4; ++i) {
+      recorder.record(0, TraceOp::Read);
+      recorder.record(1, TraceOp::Read);
+    }
+  }
+
+  TraceReplayer reads(readsFile);
+  EXPECT_EQ(reads.simulate(TapeConfig{10, 0, 0, 0}, 2), 80);
+
+  // Медленный второй привод определяет общее время.
+  EXPECT_EQ(writes.simulate({DriveConfig{0, 1, 0, 0},
+                             DriveConfig{0, 10, 0, 0}}),
+            40);
+}
+
+TEST_F(TraceTest, RejectsCorruptedTrace) {
+  {
+    std::ofstream file(traceFile, std::ios::binary);
+    file << "NOPE";
+  }
+
+  EXPECT_THROW(TraceReplayer{traceFile}, std::runtime_error);
+
+  {
+    std::ofstream file(traceFile, std::ios::binary);
+    file.write("TSTR\x01\x07", 6);
+  }
+
+  EXPECT_THROW(TraceReplayer{traceFile}, std::runtime_error);
+}
+
+TEST_F(TraceTest, SorterTracesTempTapes) {
+  std::vector<int> data = {9, 3, 7, 1, 8, 2, 6, 4, 5, 0};
+
+  auto input = std::make_unique<BinaryFileTape>(
+      tempDir + "/input.bin", data.size() * sizeof(int), cfg);
+  for (int value : data) {
+    input->write(value);
+    input->moveRight();
+  }
+
+  BinaryFileTape output(tempDir + "/output.bin", data.size() * sizeof(int),
+                        cfg);
+
+  {
+    TraceRecorder recorder(traceFile);
+    TracingTape tracedInput(std::make_unique<TapeView>(*input), recorder);
+    TracingTape tracedOutput(std::make_unique<TapeView>(output), recorder);
+
+    TapeSorter sorter(3 * sizeof(int), cfg, tempDir + "/tmp");
+    sorter.setTraceRecorder(&recorder);
+    sorter.sort(tracedInput, tracedOutput);
+  }
+
+  TraceReplayer replayer(traceFile);
+  const TraceSummary &summary = replayer.getSummary();
+
+  // Вход, выход, 4 серии и 2 промежуточных слияния.
+  EXPECT_EQ(summary.tapes, 8u);
+  // Каждый элемент читается и пишется трижды: при разбиении на серии, на
+  // промежуточном уровне и при финальном слиянии.
+  EXPECT_EQ(summary.count(TraceOp::Read), 3 * data.size());
+  EXPECT_EQ(summary.count(TraceOp::Write), 3 * data.size());
+  EXPECT_GT(replayer.simulate(TapeConfig{1, 1, 1, 1}), 0);
+}
@@ -142,3 +142,27 @@ TEST_F(UtilsTest, ClearFileThrowsWhenDirectory) {
       },
       std::runtime_error);
 }
+
+TEST_F(UtilsTest, GetFileSizeBeyondFourGigabytes) {
+#ifdef _WIN32
+  GTEST_SKIP() << "Sparse files are not created by resize_file on Windows";
+#endif
+
+  const std::string filename = "test_temp_utils/sparse.bin";
+  const size_t bytes = (size_t{5} << 30) + 12;
+
+  std::ofstream(filename, std::ios::binary).close();
+
+  std::error_code error;
+  fs::resize_file(filename, bytes, error);
+  if (error) {
+    GTEST_SKIP() << "Filesystem does not support large sparse files";
+  }
+
+  EXPECT_EQ(utils::getFileSize(filename), bytes);
+
+  auto tape = utils::createTape(bytes, config, filename, ".bin");
+  EXPECT_EQ(tape->getSize(), bytes / sizeof(int));
+
+  EXPECT_EQ(utils::getFileSize("test_temp_utils/missing.bin"), 0u);
+}